@@ -9,6 +9,27 @@
 #include "nRF24L01.h"
 #include "RF24_config.h"
 #include "RF24.h"
+#if defined(RF24_LINUX)
+    #include <time.h> // clock_gettime()
+#endif
+
+// what the RX_ADDR_P0 register holds (see RF24::pipe0_content)
+enum
+{
+    PIPE0_UNKNOWN,
+    PIPE0_READING, // pipe0_reading_address
+    PIPE0_WRITING  // pipe0_writing_address
+};
+
+#if defined(RF24_LINUX)
+// the time base of the payload timestamps (and of the GPIO character device's line events)
+static uint64_t monotonic_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+#endif
 
 /****************************************************************************/
 
@@ -102,6 +123,19 @@ void RF24::csn(bool mode)
 
 void RF24::ce(bool level)
 {
+#if defined(RF24_SPI_BATCH)
+    // queued SPI operations must reach the radio before CE changes its mode
+    if (batch_count) {
+        batch_flush();
+    }
+#endif
+#if defined(RF24_CE_HANDLE)
+    if (ce_line >= 0) {
+        // skip the pin lookup done by digitalWrite()
+        GPIO::write(ce_line, ce_values, level);
+        return;
+    }
+#endif
 #ifndef RF24_LINUX
     //Allow for 3-pin use on ATTiny
     if (ce_pin != csn_pin) {
@@ -116,6 +150,15 @@ void RF24::ce(bool level)
 
 inline void RF24::beginTransaction()
 {
+#if defined(RF24_IRQ_CONTEXT)
+    pthread_mutex_lock(&spi_lock); // released by endTransaction()
+#endif
+#if defined(RF24_SPI_BATCH)
+    // keep the order of operations if some are still queued
+    if (batch_count) {
+        batch_flush();
+    }
+#endif
 #if defined(RF24_SPI_TRANSACTIONS)
     #if defined(RF24_SPI_PTR)
         #if defined(RF24_RP2)
@@ -142,12 +185,97 @@ inline void RF24::endTransaction()
     _SPI.endTransaction();
     #endif // !defined(RF24_SPI_PTR)
 #endif     // defined (RF24_SPI_TRANSACTIONS)
+#if defined(RF24_IRQ_CONTEXT)
+    pthread_mutex_unlock(&spi_lock);
+#endif
+}
+
+/****************************************************************************/
+
+void RF24::beginBatch()
+{
+#if defined(RF24_IRQ_CONTEXT)
+    pthread_mutex_lock(&spi_lock); // the queue is not shared until endBatch()
+#endif
+#if defined(RF24_SPI_BATCH)
+    ++batch_depth;
+#endif
+}
+
+/****************************************************************************/
+
+void RF24::endBatch()
+{
+#if defined(RF24_SPI_BATCH)
+    if (batch_depth && !--batch_depth && batch_count) {
+        batch_flush();
+    }
+#endif
+#if defined(RF24_IRQ_CONTEXT)
+    pthread_mutex_unlock(&spi_lock);
+#endif
+}
+
+/****************************************************************************/
+#if defined(RF24_SPI_BATCH)
+
+void RF24::batch_queue(uint8_t command, const uint8_t* buf, uint8_t len)
+{
+    if (batch_count >= SPI_BATCH_MAX_FRAMES || batch_size + len + 1 > RF24_SPI_BATCH_SIZE) {
+        batch_flush(); // queue is full
+    }
+    uint8_t* ptx = batch_buff + batch_size;
+    *ptx++ = command;
+    for (uint8_t i = 0; i < len; ++i) {
+        *ptx++ = buf ? *buf++ : RF24_NOP; // a frame without data is for reading
+    }
+    batch_lengths[batch_count++] = static_cast<uint8_t>(len + 1);
+    batch_size = static_cast<uint8_t>(batch_size + len + 1);
+}
+
+/****************************************************************************/
+
+void RF24::batch_flush()
+{
+    _SPI.transferBatch(reinterpret_cast<char*>(batch_buff), batch_lengths, batch_count);
+    status = batch_buff[batch_size - batch_lengths[batch_count - 1]]; // status is 1st byte of the last frame
+    batch_count = 0;
+    batch_size = 0;
+}
+
+#endif // defined(RF24_SPI_BATCH)
+/****************************************************************************/
+
+#if defined(RF24_SHADOW_REGISTERS)
+/**
+ * Map a register address to its index in RF24::shadow.
+ * @return RF24_SHADOW_SIZE if the register is not cached
+ */
+static uint8_t shadow_index(uint8_t reg)
+{
+    if (reg >= EN_AA && reg <= RF_SETUP) {
+        return static_cast<uint8_t>(reg - EN_AA); // 0 - 5
+    }
+    if (reg >= RX_PW_P0 && reg <= RX_PW_P5) {
+        return static_cast<uint8_t>(reg - RX_PW_P0 + 6); // 6 - 11
+    }
+    if (reg == DYNPD || reg == FEATURE) {
+        return static_cast<uint8_t>(reg - DYNPD + 12); // 12 - 13
+    }
+    return RF24_SHADOW_SIZE;
 }
 
+#endif // defined(RF24_SHADOW_REGISTERS)
 /****************************************************************************/
 
 void RF24::read_register(uint8_t reg, uint8_t* buf, uint8_t len)
 {
+#if defined(RF24_SPI_BATCH)
+    if (batch_depth && !len) {
+        batch_queue(reg, nullptr, 0); // a command without a response can be queued
+        return;
+    }
+#endif
 #if defined(RF24_LINUX) || defined(RF24_RP2)
     beginTransaction(); //configures the spi settings for RPi, locks mutex and setting csn low
     uint8_t* prx = spi_rxbuff;
@@ -201,6 +329,13 @@ uint8_t RF24::read_register(uint8_t reg)
 {
     uint8_t result;
 
+#if defined(RF24_SHADOW_REGISTERS)
+    uint8_t index = shadow_index(reg);
+    if (index < RF24_SHADOW_SIZE && shadow_valid & (1 << index)) {
+        return shadow[index];
+    }
+#endif
+
 #if defined(RF24_LINUX) || defined(RF24_RP2)
     beginTransaction();
 
@@ -234,6 +369,12 @@ uint8_t RF24::read_register(uint8_t reg)
     endTransaction();
 #endif     // !defined(RF24_LINUX) && !defined(RF24_RP2)
 
+#if defined(RF24_SHADOW_REGISTERS)
+    if (index < RF24_SHADOW_SIZE) {
+        shadow[index] = result;
+        shadow_valid |= static_cast<uint16_t>(1 << index);
+    }
+#endif
     return result;
 }
 
@@ -241,6 +382,17 @@ uint8_t RF24::read_register(uint8_t reg)
 
 void RF24::write_register(uint8_t reg, const uint8_t* buf, uint8_t len)
 {
+#if defined(RF24_LINUX)
+    if (auto_recover) {
+        recover_track(reg, buf, len);
+    }
+#endif
+#if defined(RF24_SPI_BATCH)
+    if (batch_depth) {
+        batch_queue(static_cast<uint8_t>(W_REGISTER | reg), buf, len);
+        return;
+    }
+#endif
 #if defined(RF24_LINUX) || defined(RF24_RP2)
     beginTransaction();
     uint8_t* prx = spi_rxbuff;
@@ -285,6 +437,24 @@ void RF24::write_register(uint8_t reg, const uint8_t* buf, uint8_t len)
 void RF24::write_register(uint8_t reg, uint8_t value)
 {
     IF_RF24_DEBUG(printf_P(PSTR("write_register(%02x,%02x)\r\n"), reg, value));
+#if defined(RF24_LINUX)
+    if (auto_recover) {
+        recover_track(reg, &value, 1);
+    }
+#endif
+#if defined(RF24_SHADOW_REGISTERS)
+    uint8_t index = shadow_index(reg);
+    if (index < RF24_SHADOW_SIZE) {
+        shadow[index] = value;
+        shadow_valid |= static_cast<uint16_t>(1 << index);
+    }
+#endif
+#if defined(RF24_SPI_BATCH)
+    if (batch_depth) {
+        batch_queue(static_cast<uint8_t>(W_REGISTER | reg), &value, 1);
+        return;
+    }
+#endif
 #if defined(RF24_LINUX) || defined(RF24_RP2)
     beginTransaction();
     uint8_t* prx = spi_rxbuff;
@@ -318,21 +488,62 @@ void RF24::write_register(uint8_t reg, uint8_t value)
 
 void RF24::write_payload(const void* buf, uint8_t data_len, const uint8_t writeType)
 {
-    const uint8_t* current = reinterpret_cast<const uint8_t*>(buf);
+    rf24_iovec_t seg = {buf, data_len};
+    write_payload(&seg, 1, writeType);
+}
+
+/****************************************************************************/
+
+void RF24::write_payload(const rf24_iovec_t* segs, uint8_t nsegs, const uint8_t writeType)
+{
+    uint8_t max_len = dynamic_payloads_enabled ? static_cast<uint8_t>(32) : payload_size;
+    uint8_t data_len = 0;
+    for (uint8_t i = 0; i < nsegs && data_len < max_len; ++i) {
+        data_len = static_cast<uint8_t>(data_len + rf24_min(segs[i].len, static_cast<uint8_t>(max_len - data_len)));
+    }
 
     uint8_t blank_len = !data_len ? 1 : 0;
     if (!dynamic_payloads_enabled) {
-        data_len = rf24_min(data_len, payload_size);
         blank_len = static_cast<uint8_t>(payload_size - data_len);
     }
-    else {
-        data_len = rf24_min(data_len, static_cast<uint8_t>(32));
-    }
 
     //printf("[Writing %u bytes %u blanks]",data_len,blank_len);
     IF_RF24_DEBUG(printf_P("[Writing %u bytes %u blanks]\n", data_len, blank_len););
 
 #if defined(RF24_LINUX) || defined(RF24_RP2)
+    #if defined(SPI_HAS_GATHER)
+    if (nsegs > 1 && nsegs + 2 <= SPI_BATCH_MAX_FRAMES) {
+        // hand the segments to the SPI driver as they are
+        // (a single buffer is cheaper to copy into 1 transfer below)
+        static const uint8_t blanks[32] = {0};
+        const char* txBufs[SPI_BATCH_MAX_FRAMES];
+        uint8_t lengths[SPI_BATCH_MAX_FRAMES];
+        uint8_t count = 0;
+
+        spi_txbuff[0] = writeType;
+        txBufs[count] = reinterpret_cast<const char*>(spi_txbuff);
+        lengths[count++] = 1;
+        for (uint8_t i = 0; i < nsegs && data_len; ++i) {
+            uint8_t len = rf24_min(segs[i].len, data_len);
+            if (len) {
+                txBufs[count] = reinterpret_cast<const char*>(segs[i].base);
+                lengths[count++] = len;
+                data_len = static_cast<uint8_t>(data_len - len);
+            }
+        }
+        if (blank_len) {
+            txBufs[count] = reinterpret_cast<const char*>(blanks);
+            lengths[count++] = blank_len;
+        }
+
+        beginTransaction();
+        _SPI.transferGather(txBufs, lengths, count, reinterpret_cast<char*>(spi_rxbuff));
+        status = spi_rxbuff[0]; // status is 1st byte of receive buffer
+        endTransaction();
+        return;
+    }
+    #endif // defined(SPI_HAS_GATHER)
+
     beginTransaction();
     uint8_t* prx = spi_rxbuff;
     uint8_t* ptx = spi_txbuff;
@@ -340,8 +551,13 @@ void RF24::write_payload(const void* buf, uint8_t data_len, const uint8_t writeT
     size = static_cast<uint8_t>(data_len + blank_len + 1); // Add register value to transmit buffer
 
     *ptx++ = writeType;
-    while (data_len--) {
-        *ptx++ = *current++;
+    for (uint8_t i = 0; i < nsegs && data_len; ++i) {
+        const uint8_t* current = reinterpret_cast<const uint8_t*>(segs[i].base);
+        uint8_t len = rf24_min(segs[i].len, data_len);
+        data_len = static_cast<uint8_t>(data_len - len);
+        while (len--) {
+            *ptx++ = *current++;
+        }
     }
 
     while (blank_len--) {
@@ -362,8 +578,13 @@ void RF24::write_payload(const void* buf, uint8_t data_len, const uint8_t writeT
     beginTransaction();
     #if defined(RF24_SPI_PTR)
     status = _spi->transfer(writeType);
-    while (data_len--) {
-        _spi->transfer(*current++);
+    for (uint8_t i = 0; i < nsegs && data_len; ++i) {
+        const uint8_t* current = reinterpret_cast<const uint8_t*>(segs[i].base);
+        uint8_t len = rf24_min(segs[i].len, data_len);
+        data_len = static_cast<uint8_t>(data_len - len);
+        while (len--) {
+            _spi->transfer(*current++);
+        }
     }
 
     while (blank_len--) {
@@ -372,8 +593,13 @@ void RF24::write_payload(const void* buf, uint8_t data_len, const uint8_t writeT
 
     #else // !defined(RF24_SPI_PTR)
     status = _SPI.transfer(writeType);
-    while (data_len--) {
-        _SPI.transfer(*current++);
+    for (uint8_t i = 0; i < nsegs && data_len; ++i) {
+        const uint8_t* current = reinterpret_cast<const uint8_t*>(segs[i].base);
+        uint8_t len = rf24_min(segs[i].len, data_len);
+        data_len = static_cast<uint8_t>(data_len - len);
+        while (len--) {
+            _SPI.transfer(*current++);
+        }
     }
 
     while (blank_len--) {
@@ -469,6 +695,11 @@ void RF24::read_payload(void* buf, uint8_t data_len)
 uint8_t RF24::flush_rx(void)
 {
     read_register(FLUSH_RX, (uint8_t*)nullptr, 0);
+    rx_handled();
+#if defined(RF24_LINK_STATS)
+    ++link_stats.flushes;
+    rx_full_seen = false;
+#endif
     IF_RF24_DEBUG(printf_P("[Flushing RX FIFO]"););
     return status;
 }
@@ -478,6 +709,10 @@ uint8_t RF24::flush_rx(void)
 uint8_t RF24::flush_tx(void)
 {
     read_register(FLUSH_TX, (uint8_t*)nullptr, 0);
+#if defined(RF24_LINK_STATS)
+    ++link_stats.flushes;
+    tx_pending = 0;
+#endif
     IF_RF24_DEBUG(printf_P("[Flushing RX FIFO]"););
     return status;
 }
@@ -504,53 +739,45 @@ void RF24::print_observe_tx(uint8_t value)
 
 /****************************************************************************/
 
-void RF24::print_byte_register(const char* name, uint8_t reg, uint8_t qty)
+void RF24::print_byte_register(const char* name, const uint8_t* values, uint8_t qty)
 {
     printf_P(PSTR(PRIPSTR
                   "\t="),
              name);
     while (qty--) {
-        printf_P(PSTR(" 0x%02x"), read_register(reg++));
+        printf_P(PSTR(" 0x%02x"), *values++);
     }
     printf_P(PSTR("\r\n"));
 }
 
 /****************************************************************************/
 
-void RF24::print_address_register(const char* name, uint8_t reg, uint8_t qty)
+void RF24::print_address_register(const char* name, const uint8_t* addresses, uint8_t qty)
 {
 
     printf_P(PSTR(PRIPSTR
                   "\t="),
              name);
     while (qty--) {
-        uint8_t* buffer = new uint8_t[addr_width];
-        read_register(reg++, buffer, addr_width);
-
         printf_P(PSTR(" 0x"));
-        uint8_t* bufptr = buffer + addr_width;
-        while (--bufptr >= buffer) {
-            printf_P(PSTR("%02x"), *bufptr); // NOLINT: clang-tidy seems to emit a false positive about zero-allocated memory here (*bufptr)
+        const uint8_t* bufptr = addresses + addr_width;
+        while (--bufptr >= addresses) {
+            printf_P(PSTR("%02x"), *bufptr);
         }
-        delete[] buffer;
+        addresses += 5; // the snapshot holds 5 bytes per address
     }
     printf_P(PSTR("\r\n"));
 }
 
 /****************************************************************************/
 
-uint8_t RF24::sprintf_address_register(char* out_buffer, uint8_t reg, uint8_t qty)
+uint8_t RF24::sprintf_address_register(char* out_buffer, const uint8_t* address)
 {
     uint8_t offset = 0;
-    uint8_t* read_buffer = new uint8_t[addr_width];
-    while (qty--) {
-        read_register(reg++, read_buffer, addr_width);
-        uint8_t* bufptr = read_buffer + addr_width;
-        while (--bufptr >= read_buffer) {
-            offset += sprintf_P(out_buffer + offset, PSTR("%02X"), *bufptr); // NOLINT(clang-analyzer-cplusplus.NewDelete)
-        }
+    const uint8_t* bufptr = address + addr_width;
+    while (--bufptr >= address) {
+        offset += sprintf_P(out_buffer + offset, PSTR("%02X"), *bufptr);
     }
-    delete[] read_buffer;
     return offset;
 }
 #endif // !defined(MINIMAL)
@@ -603,6 +830,68 @@ void RF24::_init_obj()
     _spi = &SPI;
 #endif // defined (RF24_SPI_PTR)
 
+#if defined(RF24_SPI_BATCH)
+    batch_count = 0;
+    batch_size = 0;
+    batch_depth = 0;
+#endif
+
+#if defined(RF24_SHADOW_REGISTERS)
+    shadow_valid = 0;
+#endif
+
+#if defined(RF24_CE_HANDLE)
+    ce_line = -1;
+    ce_values.mask = 1ULL; // only change the value of the CE pin
+    ce_values.bits = 0ULL;
+#endif
+
+#if defined(RF24_IRQ_WAIT)
+    irq_pin = RF24_PIN_INVALID;
+#endif
+
+#if defined(RF24_IRQ_CONTEXT)
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE); // batches nest SPI transactions
+    pthread_mutex_init(&spi_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    irq_attached = RF24_PIN_INVALID;
+    irq_handler = nullptr;
+    irq_context = nullptr;
+    irq_edge = 0;
+#endif
+
+    fast_turnaround = false;
+    pipe0_content = PIPE0_UNKNOWN;
+    rx_time = 0;
+
+#if defined(RF24_LINUX)
+    rx_stamp = 0;
+    rx_cleared = monotonic_ns();
+    tx_record.start = 0;
+    tx_record.end = 0;
+    tx_record.delivered = false;
+#endif
+
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+    hw_timeout = RF24_HARDWARE_TIMEOUT;
+    last_error = RF24_ERR_NONE;
+    error_handler = nullptr;
+    error_context = nullptr;
+#endif
+
+#if defined(RF24_LINUX)
+    auto_recover = false;
+#endif
+
+#if defined(RF24_LINK_STATS)
+    resetLinkStats();
+    tx_pending = 0;
+    plos_last = 0;
+    rx_full_seen = false;
+#endif
+
     if (spi_speed <= 35000) { //Handle old BCM2835 speed constants, default to RF24_SPI_SPEED
         spi_speed = RF24_SPI_SPEED;
     }
@@ -629,9 +918,11 @@ void RF24::setPayloadSize(uint8_t size)
     payload_size = static_cast<uint8_t>(rf24_max(1, rf24_min(32, size)));
 
     // write static payload size setting for all pipes
+    beginBatch();
     for (uint8_t i = 0; i < 6; ++i) {
         write_register(static_cast<uint8_t>(RX_PW_P0 + i), payload_size);
     }
+    endBatch();
 }
 
 /****************************************************************************/
@@ -645,6 +936,15 @@ uint8_t RF24::getPayloadSize(void)
 
 #if !defined(MINIMAL)
 
+// the offsets of registers in the output of encodeRadioDetails()
+// (the registers up to RPD are at the offset of their address)
+#define RF24_DETAILS_RX_ADDR_P0 10 // 5 bytes each for pipes 0 & 1
+#define RF24_DETAILS_RX_ADDR_P2 20 // 1 byte each for pipes 2-5
+#define RF24_DETAILS_TX_ADDR    24
+#define RF24_DETAILS_RX_PW_P0   29 // followed by the other pipes and FIFO_STATUS
+#define RF24_DETAILS_DYNPD      36 // followed by FEATURE
+#define RF24_DETAILS_PINS       38
+
 static const PROGMEM char rf24_datarate_e_str_0[] = "= 1 MBPS";
 static const PROGMEM char rf24_datarate_e_str_1[] = "= 2 MBPS";
 static const PROGMEM char rf24_datarate_e_str_2[] = "= 250 KBPS";
@@ -692,6 +992,11 @@ static const PROGMEM char* const rf24_feature_e_str_P[] = {
 
 void RF24::printDetails(void)
 {
+    // format a single snapshot of the registers
+    uint8_t encoded[RF24_DETAILS_SIZE];
+    encodeRadioDetails(encoded);
+    rf24_details_t details;
+    rf24_decode_details(encoded, &details);
 
     #if defined(RF24_LINUX)
     printf("================ SPI Configuration ================\n");
@@ -705,39 +1010,45 @@ void RF24::printDetails(void)
     printf("================ NRF Configuration ================\n");
     #endif // defined(RF24_LINUX)
 
-    uint8_t status = update();
+    uint8_t status = encoded[NRF_STATUS];
     printf_P(PSTR("STATUS\t\t= 0x%02x "), status);
     printStatus(status);
 
-    print_address_register(PSTR("RX_ADDR_P0-1"), RX_ADDR_P0, 2);
-    print_byte_register(PSTR("RX_ADDR_P2-5"), RX_ADDR_P2, 4);
-    print_address_register(PSTR("TX_ADDR\t"), TX_ADDR);
+    print_address_register(PSTR("RX_ADDR_P0-1"), encoded + RF24_DETAILS_RX_ADDR_P0, 2);
+    print_byte_register(PSTR("RX_ADDR_P2-5"), encoded + RF24_DETAILS_RX_ADDR_P2, 4);
+    print_address_register(PSTR("TX_ADDR\t"), encoded + RF24_DETAILS_TX_ADDR);
 
-    print_byte_register(PSTR("RX_PW_P0-6"), RX_PW_P0, 6);
-    print_byte_register(PSTR("EN_AA\t"), EN_AA);
-    print_byte_register(PSTR("EN_RXADDR"), EN_RXADDR);
-    print_byte_register(PSTR("RF_CH\t"), RF_CH);
-    print_byte_register(PSTR("RF_SETUP"), RF_SETUP);
-    print_byte_register(PSTR("CONFIG\t"), NRF_CONFIG);
-    print_byte_register(PSTR("DYNPD/FEATURE"), DYNPD, 2);
+    print_byte_register(PSTR("RX_PW_P0-6"), encoded + RF24_DETAILS_RX_PW_P0, 6);
+    print_byte_register(PSTR("EN_AA\t"), encoded + EN_AA);
+    print_byte_register(PSTR("EN_RXADDR"), encoded + EN_RXADDR);
+    print_byte_register(PSTR("RF_CH\t"), encoded + RF_CH);
+    print_byte_register(PSTR("RF_SETUP"), encoded + RF_SETUP);
+    print_byte_register(PSTR("CONFIG\t"), encoded + NRF_CONFIG);
+    print_byte_register(PSTR("DYNPD/FEATURE"), encoded + RF24_DETAILS_DYNPD, 2);
 
     printf_P(PSTR("Data Rate\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[getDataRate()])));
+             (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[details.dataRate])));
     printf_P(PSTR("Model\t\t= " PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_model_e_str_P[isPVariant()])));
+             (char*)(pgm_read_ptr(&rf24_model_e_str_P[details.isPVariant])));
     printf_P(PSTR("CRC Length\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[getCRCLength()])));
+             (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[details.crcLength])));
     printf_P(PSTR("PA Power\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[getPALevel()])));
-    printf_P(PSTR("ARC\t\t= %d\r\n"), getARC());
+             (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[details.paLevel])));
+    printf_P(PSTR("ARC\t\t= %d\r\n"), details.retries);
 }
 
 void RF24::printPrettyDetails(void)
 {
+    // format a single snapshot of the registers
+    uint8_t encoded[RF24_DETAILS_SIZE];
+    encodeRadioDetails(encoded);
+    rf24_details_t details;
+    rf24_decode_details(encoded, &details);
+    config_reg = encoded[NRF_CONFIG];
 
     #if defined(RF24_LINUX)
     printf("================ SPI Configuration ================\n");
@@ -751,50 +1062,44 @@ void RF24::printPrettyDetails(void)
     printf("================ NRF Configuration ================\n");
     #endif // defined(RF24_LINUX)
 
-    uint8_t channel = getChannel();
-    uint16_t frequency = static_cast<uint16_t>(channel + 2400);
-    printf_P(PSTR("Channel\t\t\t= %u (~ %u MHz)\r\n"), channel, frequency);
+    uint16_t frequency = static_cast<uint16_t>(details.channel + 2400);
+    printf_P(PSTR("Channel\t\t\t= %u (~ %u MHz)\r\n"), details.channel, frequency);
     printf_P(PSTR("Model\t\t\t= " PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_model_e_str_P[isPVariant()])));
+             (char*)(pgm_read_ptr(&rf24_model_e_str_P[details.isPVariant])));
 
     printf_P(PSTR("RF Data Rate\t\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[getDataRate()])));
+             (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[details.dataRate])));
     printf_P(PSTR("RF Power Amplifier\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[getPALevel()])));
+             (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[details.paLevel])));
     printf_P(PSTR("RF Low Noise Amplifier\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>((read_register(RF_SETUP) & 1) * 1)])));
+             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.lnaEnabled])));
     printf_P(PSTR("CRC Length\t\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[getCRCLength()])));
-    printf_P(PSTR("Address Length\t\t= %d bytes\r\n"), (read_register(SETUP_AW) & 3) + 2);
+             (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[details.crcLength])));
+    printf_P(PSTR("Address Length\t\t= %d bytes\r\n"), details.addressWidth);
     printf_P(PSTR("Static Payload Length\t= %d bytes\r\n"), getPayloadSize());
 
-    uint8_t setupRetry = read_register(SETUP_RETR);
-    printf_P(PSTR("Auto Retry Delay\t= %d microseconds\r\n"), (setupRetry >> ARD) * 250 + 250);
-    printf_P(PSTR("Auto Retry Attempts\t= %d maximum\r\n"), setupRetry & 0x0F);
+    printf_P(PSTR("Auto Retry Delay\t= %d microseconds\r\n"), details.retryDelay);
+    printf_P(PSTR("Auto Retry Attempts\t= %d maximum\r\n"), details.retryCount);
 
-    uint8_t observeTx = read_register(OBSERVE_TX);
-    printf_P(PSTR("Packets lost on\n    current channel\t= %d\r\n"), observeTx >> 4);
-    printf_P(PSTR("Retry attempts made for\n    last transmission\t= %d\r\n"), observeTx & 0x0F);
+    printf_P(PSTR("Packets lost on\n    current channel\t= %d\r\n"), details.lostPackets);
+    printf_P(PSTR("Retry attempts made for\n    last transmission\t= %d\r\n"), details.retries);
 
-    uint8_t features = read_register(FEATURE);
     printf_P(PSTR("Multicast\t\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(static_cast<bool>(features & _BV(EN_DYN_ACK)) * 2)])));
+             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(details.dynamicAck * 2)])));
     printf_P(PSTR("Custom ACK Payload\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(static_cast<bool>(features & _BV(EN_ACK_PAY)) * 1)])));
-
-    uint8_t dynPl = read_register(DYNPD);
+             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.ackPayloads])));
     printf_P(PSTR("Dynamic Payloads\t" PRIPSTR
                   "\r\n"),
-             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>((dynPl && (features & _BV(EN_DPL))) * 1)])));
+             (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.dynamicPayloads && details.dynamicPayloadsFeature])));
 
-    uint8_t autoAck = read_register(EN_AA);
+    uint8_t autoAck = details.autoAck;
     if (autoAck == 0x3F || autoAck == 0) {
         // all pipes have the same configuration about auto-ack feature
         printf_P(PSTR("Auto Acknowledgment\t" PRIPSTR
@@ -812,21 +1117,19 @@ void RF24::printPrettyDetails(void)
                  static_cast<char>(static_cast<bool>(autoAck & _BV(ENAA_P0)) + 48));
     }
 
-    config_reg = read_register(NRF_CONFIG);
-    printf_P(PSTR("Primary Mode\t\t= %cX\r\n"), config_reg & _BV(PRIM_RX) ? 'R' : 'T');
-    print_address_register(PSTR("TX address\t"), TX_ADDR);
+    printf_P(PSTR("Primary Mode\t\t= %cX\r\n"), details.primaryRx ? 'R' : 'T');
+    print_address_register(PSTR("TX address\t"), details.txAddress);
 
-    uint8_t openPipes = read_register(EN_RXADDR);
     for (uint8_t i = 0; i < 6; ++i) {
-        bool isOpen = openPipes & _BV(i);
+        bool isOpen = details.openPipes & _BV(i);
         printf_P(PSTR("pipe %u (" PRIPSTR
                       ") bound"),
                  i, (char*)(pgm_read_ptr(&rf24_feature_e_str_P[isOpen + 3])));
         if (i < 2) {
-            print_address_register(PSTR(""), static_cast<uint8_t>(RX_ADDR_P0 + i));
+            print_address_register(PSTR(""), details.pipeAddress[i]);
         }
         else {
-            print_byte_register(PSTR(""), static_cast<uint8_t>(RX_ADDR_P0 + i));
+            print_byte_register(PSTR(""), details.pipeAddress[i]);
         }
     }
 }
@@ -835,6 +1138,12 @@ void RF24::printPrettyDetails(void)
 
 uint16_t RF24::sprintfPrettyDetails(char* debugging_information)
 {
+    // format a single snapshot of the registers
+    uint8_t encoded[RF24_DETAILS_SIZE];
+    encodeRadioDetails(encoded);
+    rf24_details_t details;
+    rf24_decode_details(encoded, &details);
+
     const char* format_string = PSTR(
         "================ SPI Configuration ================\n"
         "CSN Pin\t\t\t= %d\n"
@@ -861,20 +1170,19 @@ uint16_t RF24::sprintfPrettyDetails(char* debugging_information)
 
     uint16_t offset = sprintf_P(
         debugging_information, format_string, csn_pin, ce_pin,
-        static_cast<uint8_t>(spi_speed / 1000000), getChannel(),
-        static_cast<uint16_t>(getChannel() + 2400),
-        (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[getDataRate()])),
-        (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[getPALevel()])),
-        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>((read_register(RF_SETUP) & 1) * 1)])),
-        (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[getCRCLength()])),
-        ((read_register(SETUP_AW) & 3) + 2), getPayloadSize(),
-        ((read_register(SETUP_RETR) >> ARD) * 250 + 250),
-        (read_register(SETUP_RETR) & 0x0F), (read_register(OBSERVE_TX) >> 4),
-        (read_register(OBSERVE_TX) & 0x0F),
-        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(static_cast<bool>(read_register(FEATURE) & _BV(EN_DYN_ACK)) * 2)])),
-        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(static_cast<bool>(read_register(FEATURE) & _BV(EN_ACK_PAY)) * 1)])),
-        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>((read_register(DYNPD) && (read_register(FEATURE) & _BV(EN_DPL))) * 1)])));
-    uint8_t autoAck = read_register(EN_AA);
+        static_cast<uint8_t>(spi_speed / 1000000), details.channel,
+        static_cast<uint16_t>(details.channel + 2400),
+        (char*)(pgm_read_ptr(&rf24_datarate_e_str_P[details.dataRate])),
+        (char*)(pgm_read_ptr(&rf24_pa_dbm_e_str_P[details.paLevel])),
+        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.lnaEnabled])),
+        (char*)(pgm_read_ptr(&rf24_crclength_e_str_P[details.crcLength])),
+        details.addressWidth, getPayloadSize(),
+        details.retryDelay, details.retryCount,
+        details.lostPackets, details.retries,
+        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<uint8_t>(details.dynamicAck * 2)])),
+        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.ackPayloads])),
+        (char*)(pgm_read_ptr(&rf24_feature_e_str_P[details.dynamicPayloads && details.dynamicPayloadsFeature])));
+    uint8_t autoAck = details.autoAck;
     if (autoAck == 0x3F || autoAck == 0) {
         // all pipes have the same configuration about auto-ack feature
         offset += sprintf_P(
@@ -894,21 +1202,19 @@ uint16_t RF24::sprintfPrettyDetails(char* debugging_information)
     }
     offset += sprintf_P(
         debugging_information + offset, format_str2,
-        (read_register(NRF_CONFIG) & _BV(PRIM_RX) ? 'R' : 'T'));
-    offset += sprintf_address_register(debugging_information + offset, TX_ADDR);
-    uint8_t openPipes = read_register(EN_RXADDR);
+        (details.primaryRx ? 'R' : 'T'));
+    offset += sprintf_address_register(debugging_information + offset, details.txAddress);
     for (uint8_t i = 0; i < 6; ++i) {
         offset += sprintf_P(
             debugging_information + offset, format_str3,
-            i, ((char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<bool>(openPipes & _BV(i)) + 3]))));
+            i, ((char*)(pgm_read_ptr(&rf24_feature_e_str_P[static_cast<bool>(details.openPipes & _BV(i)) + 3]))));
         if (i < 2) {
-            offset += sprintf_address_register(
-                debugging_information + offset, static_cast<uint8_t>(RX_ADDR_P0 + i));
+            offset += sprintf_address_register(debugging_information + offset, details.pipeAddress[i]);
         }
         else {
             offset += sprintf_P(
                 debugging_information + offset, PSTR("%02X"),
-                read_register(static_cast<uint8_t>(RX_ADDR_P0 + i)));
+                details.pipeAddress[i][0]);
         }
     }
     return offset;
@@ -916,25 +1222,238 @@ uint16_t RF24::sprintfPrettyDetails(char* debugging_information)
 
 /****************************************************************************/
 
+uint16_t RF24::sprintfDetails(char* buffer, uint16_t size, rf24_details_format_e format)
+{
+    uint8_t encoded[RF24_DETAILS_SIZE];
+    encodeRadioDetails(encoded);
+    rf24_details_t details;
+    rf24_decode_details(encoded, &details);
+    return rf24_sprintf_details(&details, buffer, size, format);
+}
+
+/****************************************************************************/
+
+// the registers read by encodeRadioDetails() need 28 SPI frames (68 bytes)
+#if defined(RF24_SPI_BATCH) && SPI_BATCH_MAX_FRAMES >= 28 && RF24_SPI_BATCH_SIZE >= 68
+    #define RF24_BATCH_DETAILS
+#endif
+
 void RF24::encodeRadioDetails(uint8_t* encoded_details)
 {
+#if defined(RF24_BATCH_DETAILS)
+    beginBatch();
+    if (batch_count) {
+        batch_flush(); // the queue must only hold the reads below
+    }
+#endif
     uint8_t end = FEATURE + 1;
     for (uint8_t i = NRF_CONFIG; i < end; ++i) {
-        if (i == RX_ADDR_P0 || i == RX_ADDR_P1 || i == TX_ADDR) {
-            // get 40-bit registers
-            read_register(i, encoded_details, 5);
-            encoded_details += 5;
-        }
-        else if (i != 0x18 && i != 0x19 && i != 0x1a && i != 0x1b) { // skip undocumented registers
-            // get single byte registers
-            *encoded_details++ = read_register(i);
+        if (i == 0x18 || i == 0x19 || i == 0x1a || i == 0x1b) {
+            continue; // skip undocumented registers
         }
+        // get 40-bit registers or single byte registers
+        uint8_t len = (i == RX_ADDR_P0 || i == RX_ADDR_P1 || i == TX_ADDR) ? 5 : 1;
+#if defined(RF24_BATCH_DETAILS)
+        batch_queue(i, nullptr, len);
+#else
+        read_register(i, encoded_details, len);
+        encoded_details += len;
+#endif
     }
-    *encoded_details++ = ce_pin >> 4;
+#if defined(RF24_BATCH_DETAILS)
+    // copy the registers' values without the status bytes
+    uint8_t frames = batch_count;
+    batch_flush();
+    const uint8_t* prx = batch_buff;
+    for (uint8_t i = 0; i < frames; ++i) {
+        memcpy(encoded_details, prx + 1, batch_lengths[i] - 1);
+        encoded_details += batch_lengths[i] - 1;
+        prx += batch_lengths[i];
+    }
+    endBatch();
+#endif
+    *encoded_details++ = static_cast<uint8_t>(ce_pin >> 8);
     *encoded_details++ = ce_pin & 0xFF;
-    *encoded_details++ = csn_pin >> 4;
+    *encoded_details++ = static_cast<uint8_t>(csn_pin >> 8);
     *encoded_details++ = csn_pin & 0xFF;
-    *encoded_details = static_cast<uint8_t>((spi_speed / 1000000) | _BV(_is_p_variant * 4));
+    *encoded_details = static_cast<uint8_t>((spi_speed / 1000000) | (_is_p_variant << 4));
+}
+
+/****************************************************************************/
+
+bool rf24_decode_details(const uint8_t* encoded_details, rf24_details_t* details)
+{
+    const uint8_t* buf = encoded_details;
+    uint8_t config = buf[0];
+    uint8_t rf_setup = buf[6];
+    uint8_t status = buf[7];
+    uint8_t feature = buf[RF24_DETAILS_DYNPD + 1];
+
+    details->cePin = static_cast<rf24_gpio_pin_t>(buf[RF24_DETAILS_PINS] << 8 | buf[RF24_DETAILS_PINS + 1]);
+    details->csnPin = static_cast<rf24_gpio_pin_t>(buf[RF24_DETAILS_PINS + 2] << 8 | buf[RF24_DETAILS_PINS + 3]);
+    details->spiSpeed = buf[RF24_DETAILS_PINS + 4] & 0x0F;
+    details->isPVariant = buf[RF24_DETAILS_PINS + 4] >> 4;
+
+    details->channel = buf[RF_CH];
+    if (rf_setup & _BV(RF_DR_LOW)) {
+        details->dataRate = RF24_250KBPS;
+    }
+    else if (rf_setup & _BV(RF_DR_HIGH)) {
+        details->dataRate = RF24_2MBPS;
+    }
+    else {
+        details->dataRate = RF24_1MBPS;
+    }
+    details->paLevel = static_cast<rf24_pa_dbm_e>((rf_setup >> RF_PWR_LOW) & 3);
+    details->lnaEnabled = rf_setup & 1;
+    details->autoAck = buf[EN_AA] & 0x3F;
+    if (details->autoAck || (config & _BV(EN_CRC))) {
+        details->crcLength = (config & _BV(CRCO)) ? RF24_CRC_16 : RF24_CRC_8;
+    }
+    else {
+        details->crcLength = RF24_CRC_DISABLED;
+    }
+    details->addressWidth = static_cast<uint8_t>((buf[SETUP_AW] & 3) + 2);
+    details->retryDelay = static_cast<uint16_t>(((buf[SETUP_RETR] >> ARD) + 1) * 250);
+    details->retryCount = buf[SETUP_RETR] & 0x0F;
+    details->dynamicPayloads = buf[RF24_DETAILS_DYNPD] & 0x3F;
+    details->openPipes = buf[EN_RXADDR] & 0x3F;
+
+    memcpy(details->pipeAddress[0], buf + RF24_DETAILS_RX_ADDR_P0, 5);
+    memcpy(details->pipeAddress[1], buf + RF24_DETAILS_RX_ADDR_P0 + 5, 5);
+    for (uint8_t i = 2; i < 6; ++i) {
+        details->pipeAddress[i][0] = buf[RF24_DETAILS_RX_ADDR_P2 + i - 2];
+        memcpy(details->pipeAddress[i] + 1, buf + RF24_DETAILS_RX_ADDR_P0 + 6, 4);
+    }
+    memcpy(details->txAddress, buf + RF24_DETAILS_TX_ADDR, 5);
+    memcpy(details->payloadSize, buf + RF24_DETAILS_RX_PW_P0, 6);
+
+    details->dynamicPayloadsFeature = feature & _BV(EN_DPL);
+    details->ackPayloads = feature & _BV(EN_ACK_PAY);
+    details->dynamicAck = feature & _BV(EN_DYN_ACK);
+    details->powerUp = config & _BV(PWR_UP);
+    details->primaryRx = config & _BV(PRIM_RX);
+    details->irqMasked = config & RF24_IRQ_ALL;
+    details->irqFlags = status & RF24_IRQ_ALL;
+    details->fifoStatus = buf[RF24_DETAILS_RX_PW_P0 + 6];
+    details->lostPackets = buf[OBSERVE_TX] >> PLOS_CNT;
+    details->retries = buf[OBSERVE_TX] & 0x0F;
+    details->rpd = buf[RPD] & 1;
+
+    // the unused bits of these registers always read as 0 (a disconnected radio reads as all 0s or all 1s)
+    return !(config & 0x80) && (buf[SETUP_AW] & 3) && !(buf[SETUP_AW] & 0xFC) && !(buf[RF_CH] & 0x80) && !(status & 0x80);
+}
+
+/****************************************************************************/
+
+// the output of rf24_sprintf_details(); only size - 1 characters are stored, but all are counted
+typedef struct
+{
+    char* buffer;
+    uint16_t size;
+    uint16_t length;
+    bool json;
+} rf24_details_output_t;
+
+static void details_append(rf24_details_output_t* out, const char* text)
+{
+    for (; *text; ++text, ++out->length) {
+        if (out->length + 1 < out->size) {
+            out->buffer[out->length] = *text;
+        }
+    }
+}
+
+// the key is a format string in program memory (it may use the pipe number as "%u")
+static void details_field(rf24_details_output_t* out, const char* key, const char* value, bool quoted, uint8_t pipe)
+{
+    char name[28];
+    sprintf_P(name, key, pipe);
+    char field[48];
+    if (!out->json) {
+        sprintf_P(field, PSTR("%s=%s\n"), name, value);
+    }
+    else {
+        sprintf_P(field, quoted ? PSTR("%c\"%s\":\"%s\"") : PSTR("%c\"%s\":%s"), out->length ? ',' : '{', name, value);
+    }
+    details_append(out, field);
+}
+
+static void details_number(rf24_details_output_t* out, const char* key, unsigned long value, uint8_t pipe = 0)
+{
+    char text[11];
+    sprintf_P(text, PSTR("%lu"), value);
+    details_field(out, key, text, false, pipe);
+}
+
+static void details_bool(rf24_details_output_t* out, const char* key, bool value)
+{
+    details_field(out, key, value ? "true" : "false", false, 0);
+}
+
+static void details_hex(rf24_details_output_t* out, const char* key, uint8_t value)
+{
+    char text[5];
+    sprintf_P(text, PSTR("0x%02X"), value);
+    details_field(out, key, text, true, 0);
+}
+
+// print an address with its most significant byte first
+static void details_address(rf24_details_output_t* out, const char* key, const uint8_t* address, uint8_t width, uint8_t pipe = 0)
+{
+    char text[11] = {'\0'};
+    for (uint8_t i = 0; i < width && i < 5; ++i) {
+        sprintf_P(text + i * 2, PSTR("%02X"), address[width - 1 - i]);
+    }
+    details_field(out, key, text, true, pipe);
+}
+
+uint16_t rf24_sprintf_details(const rf24_details_t* details, char* buffer, uint16_t size, rf24_details_format_e format)
+{
+    rf24_details_output_t out = {buffer, size, 0, format == RF24_DETAILS_JSON};
+    const uint16_t kbps[] = {1000, 2000, 250}; // the values of rf24_datarate_e
+
+    details_number(&out, PSTR("ce_pin"), static_cast<unsigned long>(details->cePin));
+    details_number(&out, PSTR("csn_pin"), static_cast<unsigned long>(details->csnPin));
+    details_number(&out, PSTR("spi_mhz"), details->spiSpeed);
+    details_bool(&out, PSTR("plus_variant"), details->isPVariant);
+    details_number(&out, PSTR("channel"), details->channel);
+    details_number(&out, PSTR("data_rate_kbps"), kbps[details->dataRate]);
+    details_number(&out, PSTR("pa_level"), details->paLevel);
+    details_bool(&out, PSTR("lna"), details->lnaEnabled);
+    details_number(&out, PSTR("crc_bits"), static_cast<unsigned long>(details->crcLength * 8));
+    details_number(&out, PSTR("address_width"), details->addressWidth);
+    details_number(&out, PSTR("retry_delay_us"), details->retryDelay);
+    details_number(&out, PSTR("retry_count"), details->retryCount);
+    details_hex(&out, PSTR("auto_ack"), details->autoAck);
+    details_hex(&out, PSTR("dynamic_payloads"), details->dynamicPayloads);
+    details_hex(&out, PSTR("open_pipes"), details->openPipes);
+    details_bool(&out, PSTR("dynamic_payloads_feature"), details->dynamicPayloadsFeature);
+    details_bool(&out, PSTR("ack_payloads"), details->ackPayloads);
+    details_bool(&out, PSTR("dynamic_ack"), details->dynamicAck);
+    details_bool(&out, PSTR("power_up"), details->powerUp);
+    details_bool(&out, PSTR("primary_rx"), details->primaryRx);
+    details_hex(&out, PSTR("irq_masked"), details->irqMasked);
+    details_hex(&out, PSTR("irq_flags"), details->irqFlags);
+    details_hex(&out, PSTR("fifo_status"), details->fifoStatus);
+    details_number(&out, PSTR("lost_packets"), details->lostPackets);
+    details_number(&out, PSTR("retries"), details->retries);
+    details_bool(&out, PSTR("rpd"), details->rpd);
+    details_address(&out, PSTR("tx_address"), details->txAddress, details->addressWidth);
+    for (uint8_t i = 0; i < 6; ++i) {
+        details_address(&out, PSTR("pipe%u_address"), details->pipeAddress[i], details->addressWidth, i);
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        details_number(&out, PSTR("pipe%u_size"), details->payloadSize[i], i);
+    }
+    if (out.json) {
+        details_append(&out, "}");
+    }
+
+    if (size) {
+        buffer[out.length < size ? out.length : size - 1] = '\0';
+    }
+    return out.length;
 }
 #endif // !defined(MINIMAL)
 
@@ -1021,6 +1540,9 @@ bool RF24::_init_pins()
 #if defined(RF24_LINUX)
 
     pinMode(ce_pin, OUTPUT);
+    #if defined(RF24_CE_HANDLE)
+    ce_line = GPIO::handle(ce_pin);
+    #endif
     ce(LOW);
     delay(100);
 
@@ -1067,6 +1589,11 @@ bool RF24::_init_radio()
     // WARNING: Delay is based on P-variant whereby non-P *may* require different timing.
     delay(5);
 
+#if defined(RF24_SHADOW_REGISTERS)
+    shadow_valid = 0; // the radio may have been reset since the cache was filled
+#endif
+    pipe0_content = PIPE0_UNKNOWN; // RX_ADDR_P0 may hold its reset value again
+
     // Set 1500uS (minimum for 32B payload in ESB@250KBPS) timeouts, to make testing a little easier
     // WARNING: If this is ever lowered, either 250KBS mode with AA is broken or maximum packet
     // sizes must never be used. See datasheet for a more complete explanation.
@@ -1089,6 +1616,7 @@ bool RF24::_init_radio()
         write_register(FEATURE, 0);
     }
     ack_payloads_enabled = false; // ack payloads disabled by default
+    beginBatch();
     write_register(DYNPD, 0);     // disable dynamic payloads by default (for all pipes)
     dynamic_payloads_enabled = false;
     write_register(EN_AA, 0x3F);  // enable auto-ack on all pipes
@@ -1117,6 +1645,7 @@ bool RF24::_init_radio()
     // Do not write CE high so radio will remain in standby I mode
     // PTX should use only 22uA of power
     write_register(NRF_CONFIG, (_BV(EN_CRC) | _BV(CRCO)));
+    endBatch();
     config_reg = read_register(NRF_CONFIG);
 
     powerUp();
@@ -1129,6 +1658,7 @@ bool RF24::_init_radio()
 
 bool RF24::isChipConnected()
 {
+    shadow_discard(SETUP_AW); // always query the radio
     return read_register(SETUP_AW) == (addr_width - static_cast<uint8_t>(2));
 }
 
@@ -1146,18 +1676,27 @@ void RF24::startListening(void)
 #if !defined(RF24_TINY) && !defined(LITTLEWIRE)
     powerUp();
 #endif
+    beginBatch();
     config_reg |= _BV(PRIM_RX);
     write_register(NRF_CONFIG, config_reg);
     write_register(NRF_STATUS, RF24_IRQ_ALL);
-    ce(HIGH);
 
     // Restore the pipe0 address, if exists
     if (_is_p0_rx) {
-        write_register(RX_ADDR_P0, pipe0_reading_address, addr_width);
+        if (pipe0_outdated(PIPE0_READING)) {
+            write_register(RX_ADDR_P0, pipe0_reading_address, addr_width);
+            pipe0_content = PIPE0_READING;
+        }
     }
     else {
         closeReadingPipe(0);
     }
+    endBatch();
+    ce(HIGH);
+#if defined(RF24_LINUX)
+    rx_stamp = 0;
+    rx_cleared = monotonic_ns(); // ignore the IRQ edges caused by transmissions
+#endif
 }
 
 /****************************************************************************/
@@ -1170,7 +1709,18 @@ void RF24::stopListening(void)
     ce(LOW);
 
     //delayMicroseconds(100);
-    delayMicroseconds(static_cast<int>(txDelay));
+    if (fast_turnaround) {
+        // only wait for what is left of txDelay since the last payload was handled;
+        // the STATUS byte of the last SPI transaction saves another transaction here
+        uint32_t elapsed = (status & RF24_RX_DR) ? 0 : micros() - rx_time;
+        if (elapsed < txDelay) {
+            delayMicroseconds(static_cast<int>(txDelay - elapsed));
+        }
+    }
+    else {
+        delayMicroseconds(static_cast<int>(txDelay));
+    }
+    beginBatch();
     if (ack_payloads_enabled) {
         flush_tx();
     }
@@ -1185,105 +1735,477 @@ void RF24::stopListening(void)
         powerUp();
     }
 #endif
-    write_register(RX_ADDR_P0, pipe0_writing_address, addr_width);
-    write_register(EN_RXADDR, static_cast<uint8_t>(read_register(EN_RXADDR) | _BV(pgm_read_byte(&child_pipe_enable[0])))); // Enable RX on pipe0
+    // startListening() leaves pipe 0 open if it was opened for reading (unless toggleAllPipes() was used)
+    bool pipe0_open = fast_turnaround && _is_p0_rx && pipe0_content != PIPE0_UNKNOWN;
+    if (pipe0_outdated(PIPE0_WRITING)) {
+        write_register(RX_ADDR_P0, pipe0_writing_address, addr_width);
+        pipe0_content = PIPE0_WRITING;
+    }
+    if (!pipe0_open) {
+        write_register(EN_RXADDR, static_cast<uint8_t>(read_register(EN_RXADDR) | _BV(pgm_read_byte(&child_pipe_enable[0])))); // Enable RX on pipe0
+    }
+    endBatch();
 }
 
 /****************************************************************************/
 
 void RF24::stopListening(const uint64_t txAddress)
 {
+    if (pipe0_content == PIPE0_WRITING && memcmp(pipe0_writing_address, &txAddress, addr_width)) {
+        pipe0_content = PIPE0_UNKNOWN;
+    }
     memcpy(pipe0_writing_address, &txAddress, addr_width);
+    beginBatch();
     stopListening();
     write_register(TX_ADDR, pipe0_writing_address, addr_width);
+    endBatch();
 }
 
 /****************************************************************************/
 
 void RF24::stopListening(const uint8_t* txAddress)
 {
+    if (pipe0_content == PIPE0_WRITING && memcmp(pipe0_writing_address, txAddress, addr_width)) {
+        pipe0_content = PIPE0_UNKNOWN;
+    }
     memcpy(pipe0_writing_address, txAddress, addr_width);
+    beginBatch();
     stopListening();
     write_register(TX_ADDR, pipe0_writing_address, addr_width);
+    endBatch();
 }
 
 /****************************************************************************/
 
-void RF24::powerDown(void)
+void RF24::setFastTurnaround(bool enable)
 {
-    ce(LOW); // Guarantee CE is low on powerDown
-    config_reg = static_cast<uint8_t>(config_reg & ~_BV(PWR_UP));
-    write_register(NRF_CONFIG, config_reg);
+    fast_turnaround = enable;
+    rx_time = micros(); // assume a payload was just handled
 }
 
 /****************************************************************************/
 
-//Power up now. Radio will not power down unless instructed by MCU for config changes etc.
-void RF24::powerUp(void)
+bool RF24::pipe0_outdated(uint8_t content)
 {
-    // if not powered up then power up and wait for the radio to initialize
-    if (!(config_reg & _BV(PWR_UP))) {
-        config_reg |= _BV(PWR_UP);
-        write_register(NRF_CONFIG, config_reg);
+    if (!fast_turnaround || pipe0_content == PIPE0_UNKNOWN) {
+        return true;
+    }
+    // the register may hold the other cached address if both are the same
+    return pipe0_content != content && memcmp(pipe0_reading_address, pipe0_writing_address, addr_width);
+}
 
-        // For nRF24L01+ to go from power down mode to TX or RX mode it must first pass through stand-by mode.
-        // There must be a delay of Tpd2stby (see Table 16.) after the nRF24L01+ leaves power down mode before
-        // the CEis set high. - Tpd2stby can be up to 5ms per the 1.0 datasheet
-        delayMicroseconds(RF24_POWERUP_DELAY);
+/****************************************************************************/
+
+void RF24::rx_handled()
+{
+    if (fast_turnaround) {
+        rx_time = micros();
     }
+#if defined(RF24_LINUX)
+    rx_stamp = 0;
+    rx_cleared = monotonic_ns();
+#endif
 }
 
-/******************************************************************/
-#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+/****************************************************************************/
 
-void RF24::errNotify()
+#if defined(RF24_LINUX)
+uint64_t RF24::event_time(uint64_t since)
 {
-    #if defined(RF24_DEBUG) || defined(RF24_LINUX)
-    printf_P(PSTR("RF24 HARDWARE FAIL: Radio not responding, verify pin connections, wiring, etc.\r\n"));
-    #endif
-    #if defined(FAILURE_HANDLING)
-    failureDetected = 1;
-    #else
-    delay(5000);
+    #if defined(RF24_IRQ_WAIT) && defined(IRQ_HAS_TIMESTAMP)
+    if (irq_pin != RF24_PIN_INVALID) {
+        uint64_t edge = getInterruptTime(irq_pin);
+        if (edge > since) {
+            return edge;
+        }
+    }
     #endif
+    static_cast<void>(since); // ignore -Wunused-parameter
+    return monotonic_ns();
 }
 
-#endif
-/******************************************************************/
+/****************************************************************************/
 
-//Similar to the previous write, clears the interrupt flags
-bool RF24::write(const void* buf, uint8_t len, const bool multicast)
+rf24_tx_record_t RF24::getTxRecord()
 {
-    //Start Writing
-    startFastWrite(buf, len, multicast);
+    return tx_record;
+}
+#endif // defined(RF24_LINUX)
 
-//Wait until complete or failed
-#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-    uint32_t timer = millis();
-#endif // defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+/****************************************************************************/
+
+#if defined(RF24_LINK_STATS)
+rf24_link_stats_t RF24::getLinkStats()
+{
+    return link_stats;
+}
+
+/****************************************************************************/
+
+void RF24::resetLinkStats()
+{
+    memset(&link_stats, 0, sizeof(link_stats));
+}
+
+/****************************************************************************/
+
+void RF24::count_tx_acked()
+{
+    // payloads only leave the TX FIFO when delivered (or flushed, which forgets them),
+    // so an empty TX FIFO with TX_DS asserted means the pending payloads were delivered
+    if (status & RF24_TX_DS) {
+        link_stats.acked += tx_pending;
+    }
+    tx_pending = 0;
+}
+
+/****************************************************************************/
+
+void RF24::count_observe_tx(uint8_t value)
+{
+    link_stats.retries += (value >> ARC_CNT) & 0x0F;
+    uint8_t plos = (value >> PLOS_CNT) & 0x0F;
+    if (plos != plos_last) {
+        // PLOS_CNT starts over when the RF_CH register is written
+        link_stats.lost += plos > plos_last ? plos - plos_last : plos;
+        if (plos == 0x0F) {
+            ++link_stats.lostSaturated;
+        }
+        plos_last = plos;
+    }
+}
+#endif // defined(RF24_LINK_STATS)
+
+/****************************************************************************/
+
+void RF24::powerDown(void)
+{
+    ce(LOW); // Guarantee CE is low on powerDown
+    config_reg = static_cast<uint8_t>(config_reg & ~_BV(PWR_UP));
+    write_register(NRF_CONFIG, config_reg);
+}
+
+/****************************************************************************/
+
+//Power up now. Radio will not power down unless instructed by MCU for config changes etc.
+void RF24::powerUp(void)
+{
+    // if not powered up then power up and wait for the radio to initialize
+    if (!(config_reg & _BV(PWR_UP))) {
+        config_reg |= _BV(PWR_UP);
+        write_register(NRF_CONFIG, config_reg);
+
+        // For nRF24L01+ to go from power down mode to TX or RX mode it must first pass through stand-by mode.
+        // There must be a delay of Tpd2stby (see Table 16.) after the nRF24L01+ leaves power down mode before
+        // the CEis set high. - Tpd2stby can be up to 5ms per the 1.0 datasheet
+        delayMicroseconds(RF24_POWERUP_DELAY);
+    }
+}
+
+/******************************************************************/
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+
+void RF24::errNotify()
+{
+    #if defined(RF24_LINK_STATS)
+    ++link_stats.timeouts;
+    #endif
+    #if defined(FAILURE_HANDLING)
+    failureDetected = 1;
+    #endif
+    report_error(RF24_ERR_TIMEOUT);
+    #if defined(RF24_LINUX)
+    if (auto_recover) {
+        report_error(recover() ? RF24_ERR_RECOVERED : RF24_ERR_RECOVERY_FAILED);
+    }
+    else {
+        // the caller gives up on the transmission; don't leave it pending
+        ce(LOW);
+        flush_tx();
+    }
+    #endif
+}
+
+/******************************************************************/
+
+void RF24::report_error(rf24_error_e error)
+{
+    last_error = error;
+    if (error_handler) {
+        error_handler(error_context, error);
+        return;
+    }
+    #if defined(RF24_DEBUG) || defined(RF24_LINUX)
+    if (error == RF24_ERR_TIMEOUT) {
+        printf_P(PSTR("RF24 HARDWARE FAIL: Radio not responding, verify pin connections, wiring, etc.\r\n"));
+    }
+    #endif
+}
+
+/******************************************************************/
+
+void RF24::setHardwareTimeout(uint16_t timeout)
+{
+    hw_timeout = timeout;
+}
+
+/******************************************************************/
+
+rf24_error_e RF24::getLastError()
+{
+    return static_cast<rf24_error_e>(last_error);
+}
+
+/******************************************************************/
+
+void RF24::setErrorHandler(void (*handler)(void* context, rf24_error_e error), void* context)
+{
+    error_handler = handler;
+    error_context = context;
+}
+
+#endif
+/******************************************************************/
+
+#if defined(RF24_LINUX)
+
+// the single byte registers restored by recover() (NRF_CONFIG is restored from `config_reg`)
+static const uint8_t recover_list[] = {EN_AA, EN_RXADDR, SETUP_AW, SETUP_RETR, RF_CH, RF_SETUP,
+                                       RX_ADDR_P2, RX_ADDR_P3, RX_ADDR_P4, RX_ADDR_P5,
+                                       RX_PW_P0, RX_PW_P1, RX_PW_P2, RX_PW_P3, RX_PW_P4, RX_PW_P5,
+                                       DYNPD, FEATURE};
+
+// the multi-byte registers restored by recover() (the index in `recover_addrs`)
+static int8_t recover_addr_index(uint8_t reg)
+{
+    switch (reg) {
+        case RX_ADDR_P0: return 0;
+        case RX_ADDR_P1: return 1;
+        case TX_ADDR: return 2;
+        default: return -1;
+    }
+}
+
+/******************************************************************/
+
+void RF24::setAutoRecover(bool enable)
+{
+    if (enable && !auto_recover) {
+        // start from the radio's current configuration; write_register() keeps it up to date
+        for (uint8_t i = 0; i < sizeof(recover_list); ++i) {
+            recover_regs[recover_list[i]] = read_register(recover_list[i]);
+        }
+        uint8_t width = rf24_min(addr_width, static_cast<uint8_t>(sizeof(recover_addrs[0])));
+        read_register(RX_ADDR_P0, recover_addrs[0], width);
+        read_register(RX_ADDR_P1, recover_addrs[1], width);
+        read_register(TX_ADDR, recover_addrs[2], width);
+    }
+    auto_recover = enable;
+}
+
+/******************************************************************/
+
+void RF24::recover_track(uint8_t reg, const uint8_t* buf, uint8_t len)
+{
+    int8_t index = recover_addr_index(reg);
+    if (index >= 0) {
+        memcpy(recover_addrs[index], buf, rf24_min(len, 5));
+    }
+    else if (reg < sizeof(recover_regs) && len == 1) {
+        recover_regs[reg] = *buf;
+    }
+}
+
+/******************************************************************/
+
+bool RF24::recover()
+{
+    // _init_radio() sets the library's view of the configuration back to the defaults
+    uint8_t config = config_reg;
+    uint8_t size = payload_size;
+    uint8_t width = addr_width;
+    bool dynamic = dynamic_payloads_enabled;
+    bool ackPayloads = ack_payloads_enabled;
+    uint32_t tx_delay = txDelay;
+
+    ce(LOW);
+    auto_recover = false; // don't track the default configuration
+    bool responding = _init_radio();
+    auto_recover = true;
+    if (!responding) {
+        return false;
+    }
+
+    payload_size = size;
+    addr_width = width;
+    dynamic_payloads_enabled = dynamic;
+    ack_payloads_enabled = ackPayloads;
+    txDelay = tx_delay;
+    beginBatch();
+    for (uint8_t i = 0; i < sizeof(recover_list); ++i) {
+        write_register(recover_list[i], recover_regs[recover_list[i]]);
+    }
+    write_register(RX_ADDR_P0, recover_addrs[0], addr_width);
+    write_register(RX_ADDR_P1, recover_addrs[1], addr_width);
+    write_register(TX_ADDR, recover_addrs[2], addr_width);
+    config_reg = config;
+    write_register(NRF_CONFIG, config_reg);
+    endBatch();
+    return true;
+}
+
+#endif // defined(RF24_LINUX)
+/******************************************************************/
+
+#if defined(RF24_IRQ_WAIT)
+void RF24::setIrqPin(rf24_gpio_pin_t pin)
+{
+    irq_pin = pin;
+    #if defined(IRQ_HAS_TIMESTAMP)
+    if (pin != RF24_PIN_INVALID) {
+        getInterruptTime(pin); // start timestamping the pin's edges
+    }
+    #endif
+}
+
+/******************************************************************/
+
+void RF24::wait_irq(uint8_t flags, uint32_t deadline)
+{
+    // the IRQ pin only reflects the events that are not masked in the CONFIG register
+    if (irq_pin == RF24_PIN_INVALID || flags & config_reg) {
+        return;
+    }
+    // this returns immediately if the IRQ pin is already asserted (by any event),
+    // so the caller polls the STATUS byte again
+    int32_t remaining = static_cast<int32_t>(deadline - millis());
+    if (remaining > 0) {
+        waitForInterrupt(irq_pin, static_cast<uint32_t>(remaining));
+    }
+}
+
+#endif // defined(RF24_IRQ_WAIT)
+/******************************************************************/
+
+#if defined(RF24_IRQ_CONTEXT)
+bool RF24::attachIrq(rf24_gpio_pin_t pin, void (*handler)(void* context, uint8_t flags), void* context)
+{
+    detachIrq();
+    irq_handler = handler;
+    irq_context = context;
+    if (!attachInterrupt(pin, INT_EDGE_FALLING, irq_event, this)) {
+        return false;
+    }
+    irq_attached = pin;
+    return true;
+}
+
+/******************************************************************/
+
+void RF24::detachIrq()
+{
+    if (irq_attached != RF24_PIN_INVALID) {
+        detachInterrupt(irq_attached);
+        irq_attached = RF24_PIN_INVALID;
+    }
+}
+
+/******************************************************************/
+
+void RF24::irq_event(void* context, const rf24_irq_event& event)
+{
+    RF24* radio = static_cast<RF24*>(context);
+    if (!radio->irq_edge) {
+        radio->irq_edge = event.timestamp; // the earliest of the edges detected together
+    }
+    if (event.pending) {
+        return; // STATUS is read once, after the last of the edges detected together
+    }
+
+    pthread_mutex_lock(&radio->spi_lock);
+    uint8_t flags = radio->update() & RF24_IRQ_ALL;
+    #if defined(RF24_LINUX)
+    uint64_t edge = radio->irq_edge > radio->rx_cleared ? radio->irq_edge : event.timestamp;
+    if (flags & RF24_RX_DR && !radio->rx_stamp && edge > radio->rx_cleared) {
+        radio->rx_stamp = edge;
+    }
+    #endif
+    pthread_mutex_unlock(&radio->spi_lock); // the handler's SPI transactions take their turn like any other thread's
+    radio->irq_edge = 0;
+
+    if (radio->irq_handler) {
+        radio->irq_handler(radio->irq_context, flags);
+    }
+}
+
+#endif // defined(RF24_IRQ_CONTEXT)
+/******************************************************************/
+
+//Similar to the previous write, clears the interrupt flags
+bool RF24::write(const void* buf, uint8_t len, const bool multicast)
+{
+    rf24_iovec_t seg = {buf, len};
+    return write(&seg, 1, multicast);
+}
+
+bool RF24::write(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast)
+{
+    //Start Writing
+    startFastWrite(segs, nsegs, multicast);
+#if defined(RF24_LINUX)
+    tx_record.start = monotonic_ns();
+#endif
+
+//Wait until complete or failed
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+    uint32_t timer = millis();
+#endif // defined(FAILURE_HANDLING) || defined(RF24_LINUX)
 
     while (!(update() & (RF24_TX_DS | RF24_TX_DF))) {
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-        if (millis() - timer > 95) {
+        if (millis() - timer > hw_timeout) {
             errNotify();
-    #if defined(FAILURE_HANDLING)
             return 0;
-    #else
-            delay(100);
-    #endif
         }
+#endif
+#if defined(RF24_IRQ_WAIT)
+        wait_irq(RF24_TX_DS | RF24_TX_DF, timer + hw_timeout + 1);
 #endif
     }
 
+#if defined(RF24_LINUX)
+    tx_record.end = event_time(tx_record.start);
+    tx_record.delivered = !(status & RF24_TX_DF);
+#endif
+
     ce(LOW);
 
+#if defined(RF24_LINK_STATS) && defined(RF24_SPI_BATCH)
+    // fetch the retry & loss counters with the transaction that clears the flags
+    beginBatch();
+    batch_queue(OBSERVE_TX, nullptr, 1);
+    write_register(NRF_STATUS, RF24_IRQ_ALL);
+    batch_flush();
+    count_observe_tx(batch_buff[1]); // skip the status byte
+    endBatch();
+#elif defined(RF24_LINK_STATS)
+    count_observe_tx(read_register(OBSERVE_TX));
     write_register(NRF_STATUS, RF24_IRQ_ALL);
+#else
+    write_register(NRF_STATUS, RF24_IRQ_ALL);
+#endif
 
     //Max retries exceeded
     if (status & RF24_TX_DF) {
+#if defined(RF24_LINK_STATS)
+        ++link_stats.failed;
+#endif
         flush_tx(); // Only going to be 1 packet in the FIFO at a time using this method, so just flush
         return 0;
     }
+#if defined(RF24_LINK_STATS)
+    count_tx_acked();
+#endif
     //TX OK 1 or 0
     return 1;
 }
@@ -1310,16 +2232,20 @@ bool RF24::writeBlocking(const void* buf, uint8_t len, uint32_t timeout)
         if (status & RF24_TX_DF) { // If MAX Retries have been reached
             reUseTX();             // Set re-transmit and clear the MAX_RT interrupt flag
             if (millis() - timer > timeout) {
+#if defined(RF24_LINK_STATS)
+                ++link_stats.timeouts;
+#endif
                 return 0; // If this payload has exceeded the user-defined timeout, exit and return 0
             }
         }
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-        if (millis() - timer > (timeout + 95)) {
+        if (millis() - timer > (timeout + hw_timeout)) {
             errNotify();
-    #if defined(FAILURE_HANDLING)
             return 0;
-    #endif
         }
+#endif
+#if defined(RF24_IRQ_WAIT)
+        wait_irq(RF24_TX_DS | RF24_TX_DF, timer + timeout + hw_timeout + 1);
 #endif
     }
 
@@ -1333,9 +2259,14 @@ bool RF24::writeBlocking(const void* buf, uint8_t len, uint32_t timeout)
 
 void RF24::reUseTX()
 {
+#if defined(RF24_LINK_STATS)
+    ++link_stats.failed;
+#endif
     ce(LOW);
+    beginBatch();
     write_register(NRF_STATUS, RF24_TX_DF); //Clear max retry flag
     read_register(REUSE_TX_PL, (uint8_t*)nullptr, 0);
+    endBatch();
     IF_RF24_DEBUG(printf_P("[Reusing payload in TX FIFO]"););
     ce(HIGH); //Re-Transfer packet
 }
@@ -1343,6 +2274,12 @@ void RF24::reUseTX()
 /****************************************************************************/
 
 bool RF24::writeFast(const void* buf, uint8_t len, const bool multicast)
+{
+    rf24_iovec_t seg = {buf, len};
+    return writeFast(&seg, 1, multicast);
+}
+
+bool RF24::writeFast(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast)
 {
     //Block until the FIFO is NOT full.
     //Keep track of the MAX retries and set auto-retry if seeing failures
@@ -1360,15 +2297,16 @@ bool RF24::writeFast(const void* buf, uint8_t len, const bool multicast)
             // From the user perspective, if you get a 0, call txStandBy()
         }
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-        if (millis() - timer > 95) {
+        if (millis() - timer > hw_timeout) {
             errNotify();
-    #if defined(FAILURE_HANDLING)
             return 0;
-    #endif // defined(FAILURE_HANDLING)
         }
+#endif
+#if defined(RF24_IRQ_WAIT)
+        wait_irq(RF24_TX_DS | RF24_TX_DF, timer + hw_timeout + 1);
 #endif
     }
-    startFastWrite(buf, len, multicast); // Start Writing
+    startFastWrite(segs, nsegs, multicast); // Start Writing
 
     return 1;
 }
@@ -1380,6 +2318,133 @@ bool RF24::writeFast(const void* buf, uint8_t len)
 
 /****************************************************************************/
 
+size_t RF24::writeMany(const void* const* bufs, const uint8_t* lens, size_t n, bool multicast, uint32_t* ackedBitmap, rf24_tx_fail_e policy)
+{
+    size_t delivered = 0;
+    size_t head = 0;     // the oldest payload in the TX FIFO
+    size_t next = 0;     // the next payload to load into the TX FIFO
+    uint8_t retries = 0; // the number of times the payload at `head` was transmitted again
+    bool active = false; // is CE already HIGH?
+
+    if (ackedBitmap) {
+        memset(ackedBitmap, 0, ((n + 31) / 32) * sizeof(uint32_t));
+    }
+
+    // every payload in the TX FIFO must be accounted for
+    beginBatch();
+    write_register(NRF_STATUS, RF24_TX_DS | RF24_TX_DF);
+    flush_tx();
+    endBatch();
+
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+    uint32_t timer = millis();
+#endif
+
+    while (head < n) {
+        while (next < n && next - head < 3) {
+            startFastWrite(bufs[next], lens[next], multicast, false);
+            ++next;
+        }
+        if (!active) {
+            ce(HIGH);
+            active = true;
+        }
+
+        // clear TX_DS before checking the FIFO, so any later transmission asserts the IRQ pin again
+        uint8_t fifo;
+#if defined(RF24_SPI_BATCH)
+        beginBatch();
+        write_register(NRF_STATUS, RF24_TX_DS);
+        batch_queue(FIFO_STATUS, nullptr, 1);
+        batch_flush();
+        fifo = batch_buff[3]; // skip the status byte of both frames
+        endBatch();
+#else
+        write_register(NRF_STATUS, RF24_TX_DS);
+        fifo = read_register(FIFO_STATUS);
+#endif
+        rf24_fifo_state_e state = static_cast<rf24_fifo_state_e>((fifo >> 4) & 3);
+        bool failed = status & RF24_TX_DF;
+
+        // the FIFO_STATUS register can't tell 1 payload from 2
+        size_t loaded = next - head;
+        size_t occupied = state == RF24_FIFO_EMPTY ? 0 : (state == RF24_FIFO_OCCUPIED ? 2 : 3);
+        if (failed && state == RF24_FIFO_OCCUPIED) {
+            occupied = 1;
+            if (loaded > 1) {
+                // nothing is transmitted while TX_DF is asserted, so probe the FIFO with a throw-away payload
+                write_payload(bufs[head], lens[head], multicast ? W_TX_PAYLOAD_NO_ACK : W_TX_PAYLOAD);
+                occupied = isFifo(true) == RF24_FIFO_FULL ? 2 : 1;
+            }
+        }
+        size_t done = loaded > occupied ? loaded - occupied : 0;
+        for (size_t i = 0; i < done; ++i, ++head) {
+            if (ackedBitmap) {
+                ackedBitmap[head / 32] |= static_cast<uint32_t>(1) << (head % 32);
+            }
+            ++delivered;
+            retries = 0;
+        }
+#if defined(RF24_LINK_STATS)
+        link_stats.acked += static_cast<uint32_t>(done);
+        tx_pending = tx_pending > done ? tx_pending - static_cast<uint32_t>(done) : 0;
+#endif
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+        if (done || failed) {
+            timer = millis();
+        }
+#endif
+
+        if (failed) {
+            // the failed payload is at the top of the TX FIFO
+            ce(LOW);
+            active = false;
+#if defined(RF24_LINK_STATS)
+            ++link_stats.failed;
+#endif
+            if (policy == RF24_TX_ABORT) {
+                head = n;
+            }
+            else if (policy == RF24_TX_RETRY && retries < RF24_WRITE_MANY_RETRIES) {
+                ++retries;
+            }
+            else {
+                ++head;
+                retries = 0;
+            }
+            next = head; // load the flushed payloads again
+            beginBatch();
+            flush_tx();
+            write_register(NRF_STATUS, RF24_TX_DF);
+            endBatch();
+            continue;
+        }
+        if (done) {
+            continue; // load more payloads without waiting
+        }
+
+        // wait for a payload to be transmitted
+        while (!(update() & (RF24_TX_DS | RF24_TX_DF))) {
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+            if (millis() - timer > hw_timeout) {
+                ce(LOW);
+                flush_tx();
+                errNotify();
+                return delivered;
+            }
+#endif
+#if defined(RF24_IRQ_WAIT)
+            wait_irq(RF24_TX_DS | RF24_TX_DF, timer + hw_timeout + 1);
+#endif
+        }
+    }
+
+    ce(LOW);
+    return delivered;
+}
+
+/****************************************************************************/
+
 //Per the documentation, we want to set PTX Mode when not listening. Then all we do is write data and set CE high
 //In this mode, if we can keep the FIFO buffers loaded, packets will transmit immediately (no 130us delay)
 //Otherwise we enter Standby-II mode, which is still faster than standby mode
@@ -1387,8 +2452,17 @@ bool RF24::writeFast(const void* buf, uint8_t len)
 
 void RF24::startFastWrite(const void* buf, uint8_t len, const bool multicast, bool startTx)
 { //TMRh20
+    rf24_iovec_t seg = {buf, len};
+    startFastWrite(&seg, 1, multicast, startTx);
+}
 
-    write_payload(buf, len, multicast ? W_TX_PAYLOAD_NO_ACK : W_TX_PAYLOAD);
+void RF24::startFastWrite(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast, bool startTx)
+{
+    write_payload(segs, nsegs, multicast ? W_TX_PAYLOAD_NO_ACK : W_TX_PAYLOAD);
+#if defined(RF24_LINK_STATS)
+    ++link_stats.sent;
+    ++tx_pending;
+#endif
     if (startTx) {
         ce(HIGH);
     }
@@ -1403,6 +2477,10 @@ bool RF24::startWrite(const void* buf, uint8_t len, const bool multicast)
 
     // Send the payload
     write_payload(buf, len, multicast ? W_TX_PAYLOAD_NO_ACK : W_TX_PAYLOAD);
+#if defined(RF24_LINK_STATS)
+    ++link_stats.sent;
+    ++tx_pending;
+#endif
     ce(HIGH);
 #if !defined(F_CPU) || F_CPU > 20000000
     delayMicroseconds(10);
@@ -1428,6 +2506,11 @@ bool RF24::rxFifoFull()
 rf24_fifo_state_e RF24::isFifo(bool about_tx)
 {
     uint8_t state = (read_register(FIFO_STATUS) >> (4 * about_tx)) & 3;
+#if defined(RF24_LINK_STATS)
+    if (about_tx && state == RF24_FIFO_EMPTY) {
+        count_tx_acked();
+    }
+#endif
     return static_cast<rf24_fifo_state_e>(state);
 }
 
@@ -1448,22 +2531,29 @@ bool RF24::txStandBy()
 #endif
     while (!(read_register(FIFO_STATUS) & _BV(TX_EMPTY))) {
         if (status & RF24_TX_DF) {
+#if defined(RF24_LINK_STATS)
+            ++link_stats.failed;
+#endif
             write_register(NRF_STATUS, RF24_TX_DF);
             ce(LOW);
             flush_tx(); //Non blocking, flush the data
             return 0;
         }
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-        if (millis() - timeout > 95) {
+        if (millis() - timeout > hw_timeout) {
             errNotify();
-    #if defined(FAILURE_HANDLING)
             return 0;
-    #endif
         }
+#endif
+#if defined(RF24_IRQ_WAIT)
+        wait_irq(RF24_TX_DS | RF24_TX_DF, timeout + hw_timeout + 1);
 #endif
     }
 
     ce(LOW); //Set STANDBY-I mode
+#if defined(RF24_LINK_STATS)
+    count_tx_acked();
+#endif
     return 1;
 }
 
@@ -1480,26 +2570,36 @@ bool RF24::txStandBy(uint32_t timeout, bool startTx)
 
     while (!(read_register(FIFO_STATUS) & _BV(TX_EMPTY))) {
         if (status & RF24_TX_DF) {
+#if defined(RF24_LINK_STATS)
+            ++link_stats.failed;
+#endif
             write_register(NRF_STATUS, RF24_TX_DF);
             ce(LOW); // Set re-transmit
             ce(HIGH);
             if (millis() - start >= timeout) {
+#if defined(RF24_LINK_STATS)
+                ++link_stats.timeouts;
+#endif
                 ce(LOW);
                 flush_tx();
                 return 0;
             }
         }
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
-        if (millis() - start > (timeout + 95)) {
+        if (millis() - start > (timeout + hw_timeout)) {
             errNotify();
-    #if defined(FAILURE_HANDLING)
             return 0;
-    #endif
         }
+#endif
+#if defined(RF24_IRQ_WAIT)
+        wait_irq(RF24_TX_DS | RF24_TX_DF, start + timeout + hw_timeout + 1);
 #endif
     }
 
     ce(LOW); //Set STANDBY-I mode
+#if defined(RF24_LINK_STATS)
+    count_tx_acked();
+#endif
     return 1;
 }
 
@@ -1531,7 +2631,21 @@ uint8_t RF24::getDynamicPayloadSize(void)
 
 bool RF24::available(void)
 {
-    return (read_register(FIFO_STATUS) & 1) == 0;
+    uint8_t fifo = read_register(FIFO_STATUS);
+    bool ready = (fifo & 1) == 0;
+#if defined(RF24_LINK_STATS)
+    bool full = fifo & _BV(RX_FULL);
+    if (full && !rx_full_seen) {
+        ++link_stats.rxFull;
+    }
+    rx_full_seen = full;
+#endif
+#if defined(RF24_LINUX)
+    if (ready && !rx_stamp) {
+        rx_stamp = event_time(rx_cleared);
+    }
+#endif
+    return ready;
 }
 
 /****************************************************************************/
@@ -1552,9 +2666,124 @@ void RF24::read(void* buf, uint8_t len)
 
     // Fetch the payload
     read_payload(buf, len);
+#if defined(RF24_LINK_STATS)
+    uint8_t pipe = (status >> RX_P_NO) & 0x07; // status was returned before the payload left the RX FIFO
+    if (pipe < 6) {
+        ++link_stats.received[pipe];
+    }
+#endif
 
     //Clear the only applicable interrupt flags
     write_register(NRF_STATUS, RF24_RX_DR);
+    rx_handled();
+}
+
+/****************************************************************************/
+
+void RF24::read(void* buf, uint8_t len, rf24_rx_meta_t* meta)
+{
+#if defined(RF24_LINUX)
+    meta->timestamp = rx_stamp ? rx_stamp : event_time(rx_cleared);
+#endif
+
+    // only the bytes stored in buf
+    meta->length = rf24_min(dynamic_payloads_enabled ? getDynamicPayloadSize() : payload_size, len);
+    read_payload(buf, len);
+    meta->pipe = (status >> RX_P_NO) & 0x07; // status was returned before the payload left the RX FIFO
+#if defined(RF24_LINK_STATS)
+    if (meta->pipe < 6) {
+        ++link_stats.received[meta->pipe];
+    }
+#endif
+
+    write_register(NRF_STATUS, RF24_RX_DR);
+    rx_handled();
+}
+
+/****************************************************************************/
+
+uint8_t RF24::readAll(uint8_t (*buffers)[32], uint8_t maxPackets, rf24_rx_meta_t* meta)
+{
+    uint8_t count = 0;
+    uint8_t len = payload_size;
+
+    // peek at the RX FIFO; the status byte tells which pipe received the next payload
+    if (dynamic_payloads_enabled) {
+        len = read_register(R_RX_PL_WID);
+    }
+    else {
+        update();
+    }
+
+    bool cleared = false;
+    while (count < maxPackets) {
+        uint8_t pipe = (status >> RX_P_NO) & 0x07;
+        if (pipe > 5) {
+            if (!count) {
+                break; // RX FIFO is empty
+            }
+            // clear RX_DR before the final check of the RX FIFO, so that a payload
+            // arriving after this check still asserts the IRQ pin
+            write_register(NRF_STATUS, RF24_RX_DR);
+            cleared = true;
+            if (((status >> RX_P_NO) & 0x07) > 5) {
+                break; // RX FIFO is still empty
+            }
+            cleared = false; // a payload arrived before RX_DR was cleared
+            if (dynamic_payloads_enabled) {
+                len = read_register(R_RX_PL_WID);
+            }
+            continue;
+        }
+        if (len > 32 || !len) {
+            flush_rx(); // corrupted payload (like getDynamicPayloadSize())
+            break;
+        }
+        meta[count].pipe = pipe;
+        meta[count].length = len;
+#if defined(RF24_LINK_STATS)
+        ++link_stats.received[pipe];
+#endif
+#if defined(RF24_LINUX)
+        // only the first payload's arrival can be told by the IRQ pin
+        meta[count].timestamp = count ? monotonic_ns() : (rx_stamp ? rx_stamp : event_time(rx_cleared));
+#endif
+
+#if defined(RF24_SPI_BATCH)
+        // fetch the payload and peek at the next one in 1 batch
+        beginBatch();
+        batch_queue(R_RX_PAYLOAD, nullptr, len);
+        if (dynamic_payloads_enabled) {
+            batch_queue(R_RX_PL_WID, nullptr, 1);
+        }
+        else {
+            batch_queue(RF24_NOP, nullptr, 0);
+        }
+        batch_flush();
+        memcpy(buffers[count], batch_buff + 1, len); // skip the status byte
+        if (dynamic_payloads_enabled) {
+            len = batch_buff[len + 2];
+        }
+        endBatch();
+#else
+        read_payload(buffers[count], len);
+        if (dynamic_payloads_enabled) {
+            len = read_register(R_RX_PL_WID);
+        }
+        else {
+            update();
+        }
+#endif
+        ++count;
+    }
+
+    if (count) {
+        if (!cleared) {
+            write_register(NRF_STATUS, RF24_RX_DR); // the buffers are full
+        }
+        rx_handled();
+    }
+    return count;
 }
 
 /****************************************************************************/
@@ -1564,6 +2793,7 @@ void RF24::whatHappened(bool& tx_ok, bool& tx_fail, bool& rx_ready)
     // Read the status & reset the status in one easy call
     // Or is that such a good idea?
     write_register(NRF_STATUS, RF24_IRQ_ALL);
+    rx_handled();
 
     // Report to the user what happened
     tx_ok = status & RF24_TX_DS;
@@ -1576,6 +2806,9 @@ void RF24::whatHappened(bool& tx_ok, bool& tx_fail, bool& rx_ready)
 uint8_t RF24::clearStatusFlags(uint8_t flags)
 {
     write_register(NRF_STATUS, flags & RF24_IRQ_ALL);
+    if (flags & RF24_RX_DR) {
+        rx_handled();
+    }
     return status;
 }
 
@@ -1610,9 +2843,12 @@ void RF24::openWritingPipe(uint64_t value)
     // Note that AVR 8-bit uC's store this LSB first, and the NRF24L01(+)
     // expects it LSB first too, so we're good.
 
+    beginBatch();
     write_register(RX_ADDR_P0, reinterpret_cast<uint8_t*>(&value), addr_width);
     write_register(TX_ADDR, reinterpret_cast<uint8_t*>(&value), addr_width);
+    endBatch();
     memcpy(pipe0_writing_address, &value, addr_width);
+    pipe0_content = PIPE0_WRITING;
 }
 
 /****************************************************************************/
@@ -1621,9 +2857,12 @@ void RF24::openWritingPipe(const uint8_t* address)
 {
     // Note that AVR 8-bit uC's store this LSB first, and the NRF24L01(+)
     // expects it LSB first too, so we're good.
+    beginBatch();
     write_register(RX_ADDR_P0, address, addr_width);
     write_register(TX_ADDR, address, addr_width);
+    endBatch();
     memcpy(pipe0_writing_address, address, addr_width);
+    pipe0_content = PIPE0_WRITING;
 }
 
 /****************************************************************************/
@@ -1650,6 +2889,12 @@ void RF24::openReadingPipe(uint8_t child, uint64_t address)
         // NOTE, the cached RX address on pipe 0 is written when startListening() is called.
         else if (static_cast<bool>(config_reg & _BV(PRIM_RX)) || child != 0) {
             write_register(pgm_read_byte(&child_pipe[child]), reinterpret_cast<const uint8_t*>(&address), addr_width);
+            if (!child) {
+                pipe0_content = PIPE0_READING;
+            }
+        }
+        else if (pipe0_content == PIPE0_READING) {
+            pipe0_content = PIPE0_UNKNOWN; // the cached address changed
         }
 
         // Note it would be more efficient to set all of the bits for all open
@@ -1663,6 +2908,7 @@ void RF24::openReadingPipe(uint8_t child, uint64_t address)
 
 void RF24::setAddressWidth(uint8_t a_width)
 {
+    pipe0_content = PIPE0_UNKNOWN;
     a_width = static_cast<uint8_t>(a_width - 2);
     if (a_width) {
         write_register(SETUP_AW, static_cast<uint8_t>(a_width % 4));
@@ -1694,6 +2940,12 @@ void RF24::openReadingPipe(uint8_t child, const uint8_t* address)
         // NOTE, the cached RX address on pipe 0 is written when startListening() is called.
         else if (static_cast<bool>(config_reg & _BV(PRIM_RX)) || child != 0) {
             write_register(pgm_read_byte(&child_pipe[child]), address, addr_width);
+            if (!child) {
+                pipe0_content = PIPE0_READING;
+            }
+        }
+        else if (pipe0_content == PIPE0_READING) {
+            pipe0_content = PIPE0_UNKNOWN; // the cached address changed
         }
 
         // Note it would be more efficient to set all of the bits for all open
@@ -1727,10 +2979,45 @@ void RF24::toggle_features(void)
     _SPI.transfer(0x73);
 #endif
     endTransaction();
+    // ACTIVATE may have changed the access to (and the values read from) these
+    shadow_discard(FEATURE);
+    shadow_discard(DYNPD);
 }
 
 /****************************************************************************/
 
+void RF24::shadow_discard(uint8_t reg)
+{
+#if defined(RF24_SHADOW_REGISTERS)
+    uint8_t index = shadow_index(reg);
+    if (index < RF24_SHADOW_SIZE) {
+        shadow_valid = static_cast<uint16_t>(shadow_valid & ~(1 << index));
+    }
+#else
+    (void)reg;
+#endif
+}
+
+/****************************************************************************/
+
+#if defined(RF24_SHADOW_REGISTERS)
+void RF24::resyncShadow()
+{
+    shadow_valid = 0;
+    for (uint8_t reg = EN_AA; reg <= RF_SETUP; ++reg) {
+        read_register(reg);
+    }
+    for (uint8_t reg = RX_PW_P0; reg <= RX_PW_P5; ++reg) {
+        read_register(reg);
+    }
+    read_register(DYNPD);
+    read_register(FEATURE);
+}
+
+#endif // defined(RF24_SHADOW_REGISTERS)
+
+/****************************************************************************/
+
 void RF24::enableDynamicPayloads(void)
 {
     // Enable dynamic payload throughout the system
@@ -1893,6 +3180,139 @@ bool RF24::testRPD(void)
 
 /****************************************************************************/
 
+void RF24::scanChannels(uint8_t first, uint8_t last, uint16_t dwell_us, uint16_t reps, uint16_t* hits)
+{
+    last = static_cast<uint8_t>(rf24_min(last, 125));
+    if (first > last || !reps) {
+        return;
+    }
+    dwell_us = static_cast<uint16_t>(rf24_max(dwell_us, 170)); // RX settling + AGC delay (for a valid RPD)
+
+    uint8_t channel = getChannel();
+    bool was_listening = config_reg & _BV(PRIM_RX);
+    if (!was_listening) {
+        startListening();
+    }
+
+    // Setting CE low latches the RPD of the channel being left, so each hop reads the
+    // previous channel's sample along with the new RF_CH value.
+    bool sampled = false;
+    uint16_t* hit = hits;
+    while (reps--) {
+        for (uint8_t ch = first; ch <= last; ++ch) {
+            ce(LOW);
+            beginBatch();
+#if defined(RF24_SPI_BATCH)
+            if (sampled) {
+                batch_queue(RPD, nullptr, 1);
+            }
+#else
+            if (sampled) {
+                *hit += read_register(RPD) & 1;
+            }
+#endif
+            if (ch == first) {
+                read_register(FLUSH_RX, (uint8_t*)nullptr, 0); // discard noise caught in the last sweep
+            }
+            write_register(RF_CH, ch);
+#if defined(RF24_SPI_BATCH)
+            if (sampled) {
+                batch_flush();
+                *hit += batch_buff[1] & 1; // skip the status byte
+            }
+#endif
+            endBatch();
+            sampled = true;
+            hit = hits + (ch - first);
+            ce(HIGH);
+            delayMicroseconds(dwell_us);
+        }
+    }
+    ce(LOW);
+    *hit += read_register(RPD) & 1;
+
+    // go back to where the scan started
+    beginBatch();
+    read_register(FLUSH_RX, (uint8_t*)nullptr, 0);
+    write_register(NRF_STATUS, RF24_IRQ_ALL);
+    write_register(RF_CH, channel);
+    endBatch();
+    rx_handled();
+    if (was_listening) {
+        ce(HIGH);
+    }
+    else {
+        stopListening();
+    }
+}
+
+/****************************************************************************/
+
+/** The occupancy of a channel in the histogram built by RF24::selectQuietChannel() */
+static uint16_t channel_occupancy(const uint16_t* hits, uint8_t channel, bool wide)
+{
+    uint32_t occupancy = hits[channel];
+    if (wide) {
+        // a 2 Mbps transmission also occupies half of each adjacent channel
+        occupancy += ((channel ? hits[channel - 1] : 0) + (channel < 125 ? hits[channel + 1] : 0)) / 2;
+    }
+    return static_cast<uint16_t>(rf24_min(occupancy, 0xFFFFUL));
+}
+
+uint8_t RF24::selectQuietChannel(const uint8_t* channels, uint8_t count, uint16_t passes, uint8_t* ranked, uint16_t* occupancy)
+{
+    if (!channels) {
+        count = static_cast<uint8_t>(rf24_min(count, 126));
+    }
+    if (!count) {
+        return getChannel();
+    }
+
+    // scan the smallest range that covers the channels and their neighbors
+    uint8_t first = 125;
+    uint8_t last = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t channel = channels ? static_cast<uint8_t>(rf24_min(channels[i], 125)) : i;
+        first = static_cast<uint8_t>(rf24_min(first, channel));
+        last = static_cast<uint8_t>(rf24_max(last, channel));
+    }
+    first = static_cast<uint8_t>(first ? first - 1 : 0);
+    last = static_cast<uint8_t>(rf24_min(last + 1, 125));
+    uint16_t hits[126] = {0};
+    scanChannels(first, last, 170, passes, hits + first); // indexed by channel
+    bool wide = getDataRate() == RF24_2MBPS;
+
+    uint8_t best = 0;
+    uint16_t least = 0xFFFF;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t channel = channels ? static_cast<uint8_t>(rf24_min(channels[i], 125)) : i;
+        uint16_t busy = channel_occupancy(hits, channel, wide);
+        if (busy < least || !i) {
+            best = channel;
+            least = busy;
+        }
+        if (ranked) {
+            // insertion sort (stable) from the quietest to the busiest
+            uint8_t j = i;
+            while (j && channel_occupancy(hits, ranked[j - 1], wide) > busy) {
+                ranked[j] = ranked[j - 1];
+                --j;
+            }
+            ranked[j] = channel;
+        }
+    }
+    if (ranked && occupancy) {
+        for (uint8_t i = 0; i < count; ++i) {
+            occupancy[i] = channel_occupancy(hits, ranked[i], wide);
+        }
+    }
+
+    setChannel(best);
+    return best;
+}
+
+/****************************************************************************/
+
 void RF24::setPALevel(uint8_t level, bool lnaEnable)
 {
     uint8_t setup = read_register(RF_SETUP) & static_cast<uint8_t>(0xF8);
@@ -1928,6 +3348,7 @@ bool RF24::setDataRate(rf24_datarate_e speed)
     write_register(RF_SETUP, setup);
 
     // Verify our result
+    shadow_discard(RF_SETUP);
     if (read_register(RF_SETUP) == setup) {
         result = true;
     }
@@ -1984,7 +3405,9 @@ rf24_crclength_e RF24::getCRCLength(void)
 {
     rf24_crclength_e result = RF24_CRC_DISABLED;
     uint8_t AA = read_register(EN_AA);
+#if !defined(RF24_SHADOW_REGISTERS)
     config_reg = read_register(NRF_CONFIG);
+#endif
 
     if (config_reg & _BV(EN_CRC) || AA) {
         if (config_reg & _BV(CRCO)) {
@@ -2070,6 +3493,7 @@ void RF24::stopConstCarrier()
 void RF24::toggleAllPipes(bool isEnabled)
 {
     write_register(EN_RXADDR, static_cast<uint8_t>(isEnabled ? 0x3F : 0));
+    pipe0_content = PIPE0_UNKNOWN; // pipe 0 may be closed
 }
 
 /****************************************************************************/
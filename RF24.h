@@ -154,6 +154,230 @@ typedef enum
 
 /**
  * @}
+ * @brief Information about a payload fetched with RF24::readAll()
+ */
+typedef struct
+{
+    /// The pipe number that received the payload.
+    uint8_t pipe;
+    /// The length of the payload (in bytes).
+    uint8_t length;
+#if defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+    /**
+     * When the payload was received (in nanoseconds of `CLOCK_MONOTONIC`).
+     *
+     * This is the time of the IRQ pin's falling edge if the driver can timestamp it
+     * (see RF24::setIrqPin()). Otherwise, it is when the payload was first noticed by
+     * available() (or fetched).
+     * @note This member is only available on Linux.
+     */
+    uint64_t timestamp;
+#endif
+} rf24_rx_meta_t;
+
+#if defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+/**
+ * @brief The outcome of the last payload transmitted with RF24::write()
+ * @note This is only available on Linux.
+ * @see RF24::getTxRecord()
+ */
+typedef struct
+{
+    /// When the transmission was started by setting the CE pin HIGH (in nanoseconds of `CLOCK_MONOTONIC`).
+    uint64_t start;
+    /**
+     * When the transmission finished (in nanoseconds of `CLOCK_MONOTONIC`).
+     *
+     * This is the time of the IRQ pin's falling edge if the driver can timestamp it
+     * (see RF24::setIrqPin()). Otherwise, it is when the `RF24_TX_DS` or `RF24_TX_DF`
+     * flag was detected.
+     */
+    uint64_t end;
+    /// Was the payload acknowledged (or sent without expecting an acknowledgement)?
+    bool delivered;
+} rf24_tx_record_t;
+#endif
+
+#if defined(RF24_LINK_STATS) || defined(DOXYGEN_FORCED)
+/**
+ * @brief Statistics about the radio link, counted by RF24 as it goes
+ *
+ * The counters are derived from the STATUS and FIFO_STATUS bytes that the library
+ * already fetches. Only write() reads the OBSERVE_TX register too (with the transaction
+ * that clears the STATUS flags on drivers that batch SPI transactions).
+ * @note This is only available when `RF24_LINK_STATS` is defined (always the case on Linux).
+ * @see RF24::getLinkStats(), RF24::resetLinkStats()
+ */
+typedef struct
+{
+    /// The number of payloads loaded into the TX FIFO for transmission.
+    uint32_t sent;
+    /**
+     * The number of payloads known to be delivered (or sent without expecting an acknowledgement).
+     *
+     * Payloads streamed with RF24::writeFast() are counted once the TX FIFO is seen empty
+     * (by RF24::txStandBy() or RF24::isFifo()) while the `RF24_TX_DS` flag is asserted.
+     * So they are not counted if that flag was cleared first (like with RF24::whatHappened()).
+     */
+    uint32_t acked;
+    /// The number of times a payload was not acknowledged after all of its automatic retries (`RF24_TX_DF`).
+    uint32_t failed;
+    /**
+     * The cumulative number of automatic retries (ARC_CNT) of payloads transmitted with RF24::write().
+     */
+    uint32_t retries;
+    /**
+     * The number of packets lost, accumulated from the PLOS_CNT field.
+     *
+     * The radio stops counting at 15 lost packets until the channel is set again.
+     * This is updated by RF24::write().
+     */
+    uint32_t lost;
+    /// The number of times the PLOS_CNT field reached its limit (see `lost`).
+    uint32_t lostSaturated;
+    /// The number of payloads fetched from each pipe.
+    uint32_t received[6];
+    /// The number of times the RX FIFO was found full by RF24::available().
+    uint32_t rxFull;
+    /// The number of times the TX or RX FIFO was flushed.
+    uint32_t flushes;
+    /// The number of transmissions abandoned by a timeout (including unresponsive radio hardware).
+    uint32_t timeouts;
+} rf24_link_stats_t;
+#endif
+
+/**
+ * @brief A segment of a payload transmitted with RF24::write(const rf24_iovec_t*, uint8_t, const bool),
+ * RF24::writeFast(const rf24_iovec_t*, uint8_t, const bool) or
+ * RF24::startFastWrite(const rf24_iovec_t*, uint8_t, const bool, bool)
+ */
+typedef struct
+{
+    /// The segment's data.
+    const void* base;
+    /// The length of the segment (in bytes).
+    uint8_t len;
+} rf24_iovec_t;
+
+/**
+ * @brief How RF24::writeMany() handles a payload that was not acknowledged
+ * after all of its automatic retries.
+ */
+typedef enum
+{
+    /// Drop the payload and continue with the next one.
+    RF24_TX_SKIP,
+    /// Transmit the payload again (up to `RF24_WRITE_MANY_RETRIES` times) before dropping it.
+    RF24_TX_RETRY,
+    /// Drop the payload and every payload after it.
+    RF24_TX_ABORT,
+} rf24_tx_fail_e;
+
+/**
+ * @brief The failures reported by RF24::getLastError() and the handler passed to RF24::setErrorHandler()
+ */
+typedef enum
+{
+    /// No failure was detected.
+    RF24_ERR_NONE = 0,
+    /// The radio did not finish a transmission within the hardware timeout (see RF24::setHardwareTimeout()).
+    RF24_ERR_TIMEOUT,
+    /// The radio was initialized again with its previous configuration (see RF24::setAutoRecover()).
+    RF24_ERR_RECOVERED,
+    /// The radio did not respond while being initialized again (see RF24::setAutoRecover()).
+    RF24_ERR_RECOVERY_FAILED,
+} rf24_error_e;
+
+#ifndef RF24_HARDWARE_TIMEOUT
+    /** The default time (in milliseconds) after which an unfinished transmission is considered a hardware failure. */
+    #define RF24_HARDWARE_TIMEOUT 95
+#endif
+
+#ifndef RF24_WRITE_MANY_RETRIES
+    /** The number of times RF24::writeMany() transmits a failed payload again with `RF24_TX_RETRY`. */
+    #define RF24_WRITE_MANY_RETRIES 3
+#endif
+
+/** The number of bytes written by RF24::encodeRadioDetails() */
+#define RF24_DETAILS_SIZE 43
+
+/**
+ * @brief The radio details encoded by RF24::encodeRadioDetails(), as decoded by rf24_decode_details()
+ */
+typedef struct
+{
+    /// The CE pin number.
+    rf24_gpio_pin_t cePin;
+    /// The CSN pin number.
+    rf24_gpio_pin_t csnPin;
+    /// The SPI speed (in MHz).
+    uint8_t spiSpeed;
+    /// Is the radio a nRF24L01+ (or a compatible clone)?
+    bool isPVariant;
+    /// The RF channel.
+    uint8_t channel;
+    /// The data rate.
+    rf24_datarate_e dataRate;
+    /// The power amplifier level.
+    rf24_pa_dbm_e paLevel;
+    /// Is the Low Noise Amplifier enabled?
+    bool lnaEnabled;
+    /// The CRC length (the radio forces a CRC if auto-ack is enabled on any pipe).
+    rf24_crclength_e crcLength;
+    /// The address width (in bytes).
+    uint8_t addressWidth;
+    /// The delay between automatic retries (in microseconds).
+    uint16_t retryDelay;
+    /// The maximum number of automatic retries.
+    uint8_t retryCount;
+    /// The pipes with auto-ack enabled (1 bit per pipe).
+    uint8_t autoAck;
+    /// The pipes with dynamic payloads enabled (1 bit per pipe).
+    uint8_t dynamicPayloads;
+    /// The open pipes (1 bit per pipe).
+    uint8_t openPipes;
+    /// The static payload size of each pipe.
+    uint8_t payloadSize[6];
+    /// The TX address (least significant byte first).
+    uint8_t txAddress[5];
+    /// The address of each pipe (least significant byte first; pipes 2-5 share the upper bytes of pipe 1).
+    uint8_t pipeAddress[6][5];
+    /// Is the dynamic payloads feature enabled?
+    bool dynamicPayloadsFeature;
+    /// Are ACK payloads enabled?
+    bool ackPayloads;
+    /// Is transmitting without an acknowledgement allowed?
+    bool dynamicAck;
+    /// Is the radio powered up?
+    bool powerUp;
+    /// Is the radio in RX mode (or TX mode)?
+    bool primaryRx;
+    /// The IRQ events that are masked (`RF24_RX_DR`, `RF24_TX_DS` and/or `RF24_TX_DF`).
+    uint8_t irqMasked;
+    /// The IRQ events that are flagged in the STATUS register.
+    uint8_t irqFlags;
+    /// The FIFO_STATUS register.
+    uint8_t fifoStatus;
+    /// The count of lost packets (from the OBSERVE_TX register).
+    uint8_t lostPackets;
+    /// The retries made for the last transmission (from the OBSERVE_TX register).
+    uint8_t retries;
+    /// Was a signal greater than or equal to -64dBm detected?
+    bool rpd;
+} rf24_details_t;
+
+/**
+ * @brief The output formats of RF24::sprintfDetails() and rf24_sprintf_details()
+ */
+typedef enum
+{
+    /// One `key=value` line per field.
+    RF24_DETAILS_KEY_VALUE = 0,
+    /// A single JSON object.
+    RF24_DETAILS_JSON
+} rf24_details_format_e;
+
+/**
  * @brief Driver class for nRF24L01(+) 2.4GHz Wireless Transceiver
  */
 class RF24
@@ -175,9 +399,34 @@ private:
     rf24_gpio_pin_t ce_pin;  /* "Chip Enable" pin, activates the RX or TX role */
     rf24_gpio_pin_t csn_pin; /* SPI Chip select */
     uint32_t spi_speed;      /* SPI Bus Speed */
+#if defined(RF24_CE_HANDLE)
+    gpio_fd ce_line;               /* The CE pin's line request (resolved by begin()) */
+    gpio_v2_line_values ce_values; /* The buffer used to toggle `ce_line` */
+#endif
 #if defined(RF24_LINUX) || defined(XMEGA_D3) || defined(RF24_RP2)
     uint8_t spi_rxbuff[32 + 1]; //SPI receive buffer (payload max 32 bytes)
     uint8_t spi_txbuff[32 + 1]; //SPI transmit buffer (payload max 32 bytes + 1 byte for the command)
+#endif
+#if defined(RF24_SPI_BATCH)
+    uint8_t batch_buff[RF24_SPI_BATCH_SIZE];     /* Frames queued for the next batched SPI transaction */
+    uint8_t batch_lengths[SPI_BATCH_MAX_FRAMES]; /* The length of each queued frame */
+    uint8_t batch_count;                         /* The number of queued frames */
+    uint8_t batch_size;                          /* The number of queued bytes */
+    uint8_t batch_depth;                         /* The nesting level of beginBatch() calls */
+#endif
+#if defined(RF24_SHADOW_REGISTERS)
+    uint8_t shadow[RF24_SHADOW_SIZE]; /* Cached values of the configuration registers */
+    uint16_t shadow_valid;            /* A bit mask of which `shadow` values mirror the radio */
+#endif
+#if defined(RF24_IRQ_WAIT)
+    rf24_gpio_pin_t irq_pin; /* The pin connected to the radio's IRQ pin (used to sleep while transmitting) */
+#endif
+#if defined(RF24_IRQ_CONTEXT)
+    rf24_gpio_pin_t irq_attached;                      /* The IRQ pin handled by attachIrq() */
+    void (*irq_handler)(void* context, uint8_t flags); /* The user's handler passed to attachIrq() */
+    void* irq_context;                                 /* The context pointer passed to `irq_handler` */
+    uint64_t irq_edge;                                 /* The first IRQ edge not handled by irq_event() yet */
+    pthread_mutex_t spi_lock;                          /* Serializes SPI transactions with the interrupt dispatcher's thread */
 #endif
     uint8_t status;                   /* The status byte returned from every SPI transaction */
     uint8_t payload_size;             /* Fixed size of payloads */
@@ -186,6 +435,31 @@ private:
     uint8_t config_reg;               /* For storing the value of the NRF_CONFIG register */
     bool _is_p_variant;               /* For storing the result of testing the toggleFeatures() affect */
     bool _is_p0_rx;                   /* For keeping track of pipe 0's usage in user-triggered RX mode. */
+    bool fast_turnaround;             /* Skip redundant work when switching roles (see setFastTurnaround()) */
+    uint8_t pipe0_content;            /* Which cached address the RX_ADDR_P0 register holds */
+    uint32_t rx_time;                 /* micros() when a received payload was last handled (for the fast turnaround) */
+#if defined(RF24_LINUX)
+    uint64_t rx_stamp;          /* When the payload at the top of the RX FIFO was received (0 if unknown) */
+    uint64_t rx_cleared;        /* When the RX_DR flag was last cleared (older IRQ edges belong to other payloads) */
+    rf24_tx_record_t tx_record; /* The outcome of the last payload transmitted with write() */
+#endif
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
+    uint16_t hw_timeout;                                      /* Milliseconds before an unfinished transmission is a failure */
+    uint8_t last_error;                                       /* The last rf24_error_e reported */
+    void (*error_handler)(void* context, rf24_error_e error); /* The user's handler passed to setErrorHandler() */
+    void* error_context;                                      /* The context pointer passed to `error_handler` */
+#endif
+#if defined(RF24_LINUX)
+    bool auto_recover;           /* Initialize the radio again after a failure (see setAutoRecover()) */
+    uint8_t recover_regs[0x1E];  /* The single byte configuration registers to restore (indexed by address) */
+    uint8_t recover_addrs[3][5]; /* The RX_ADDR_P0, RX_ADDR_P1 & TX_ADDR registers to restore */
+#endif
+#if defined(RF24_LINK_STATS)
+    rf24_link_stats_t link_stats; /* Counters updated from the status bytes that were fetched anyway */
+    uint32_t tx_pending;          /* Payloads loaded into the TX FIFO but not yet counted as acked or flushed */
+    uint8_t plos_last;            /* The last PLOS_CNT value seen (it is reset by writing the RF_CH register) */
+    bool rx_full_seen;            /* Was the RX FIFO full when last checked? (full events are counted once) */
+#endif
 
 protected:
     /**
@@ -198,6 +472,30 @@ protected:
 
     inline void endTransaction();
 
+    /**
+     * Start queuing register writes and commands (like flush_tx()) instead of
+     * transferring each one immediately.
+     *
+     * Queued operations are submitted in a single syscall when the outermost
+     * endBatch() is called, or earlier if any operation needs a response from
+     * the radio (register reads, payload transfers) or if the CE pin is toggled.
+     * This preserves the order of operations as seen by the radio.
+     *
+     * Calls can be nested; only the outermost endBatch() submits the queue.
+     * @note This only reduces overhead on drivers that support batched SPI
+     * transactions (currently the SPIDEV driver). On other platforms, operations
+     * are transferred immediately as usual.
+     * @warning The status byte (see getStatusFlags()) is only updated when the
+     * queue is submitted.
+     */
+    void beginBatch();
+
+    /**
+     * Submit the operations queued since the matching beginBatch() call.
+     * @see beginBatch()
+     */
+    void endBatch();
+
     /** Whether ack payloads are enabled. */
     bool ack_payloads_enabled;
     /** The address width to use (3, 4 or 5 bytes). */
@@ -266,7 +564,13 @@ public:
      */
     RF24(uint32_t _spi_speed = RF24_SPI_SPEED);
 
-#if defined(RF24_LINUX)
+#if defined(RF24_IRQ_CONTEXT)
+    virtual ~RF24()
+    {
+        detachIrq();
+        pthread_mutex_destroy(&spi_lock);
+    };
+#elif defined(RF24_LINUX)
     virtual ~RF24() {};
 #endif
 
@@ -389,6 +693,26 @@ public:
      */
     void stopListening(const uint8_t* txAddress);
 
+    /**
+     * Enable or disable the fast turnaround between RX and TX modes.
+     *
+     * This is meant for half-duplex protocols where every request is answered
+     * right away. When enabled:
+     * - startListening() and stopListening() skip writing the RX_ADDR_P0 register
+     *   if it already holds the needed address.
+     * - stopListening() skips reading back the EN_RXADDR register if pipe 0 is
+     *   known to be open.
+     * - stopListening() only waits for what is left of the @ref txDelay since a
+     *   received payload was last handled (by read(), readAll(), flush_rx(),
+     *   clearStatusFlags() or whatHappened()). If the STATUS byte of the last SPI
+     *   transaction (see getStatusFlags()) still flags a payload with `RF24_RX_DR`,
+     *   then the full @ref txDelay is observed. Otherwise, the time taken to process
+     *   a request is no longer spent twice. No SPI transaction is added for this.
+     *
+     * @param enable `true` enables the fast turnaround. It is disabled by default.
+     */
+    void setFastTurnaround(bool enable);
+
     /**
      * Check whether there are bytes available to be read
      * @code
@@ -480,6 +804,54 @@ public:
      */
     void read(void* buf, uint8_t len);
 
+    /**
+     * Similar to read(void*, uint8_t) but also describes the payload.
+     *
+     * @param buf Pointer to a buffer where the data should be written
+     * @param len Maximum number of bytes to read into the buffer
+     * @param[out] meta Receives the pipe number and the number of payload bytes stored in
+     * @p buf (the payload's length, but at most `len`). On Linux, it also receives the time
+     * the payload was received.
+     *
+     * @code
+     * rf24_rx_meta_t meta;
+     * if (radio.available()) {
+     *   radio.read(&data, sizeof(data), &meta);
+     *   latency = now - meta.timestamp;
+     * }
+     * @endcode
+     */
+    void read(void* buf, uint8_t len, rf24_rx_meta_t* meta);
+
+    /**
+     * Fetch every payload waiting in the RX FIFO.
+     *
+     * This is a faster alternative to calling available(), getDynamicPayloadSize()
+     * and read() for each payload. Only 2 SPI transactions are used per payload
+     * (the payload itself and a peek at the next one), and the `RX_DR` flag is
+     * cleared only once after the RX FIFO has been emptied.
+     *
+     * @param buffers An array of 32 byte buffers where the payloads will be stored.
+     * @param maxPackets The number of buffers in the `buffers` array. This also
+     * limits the number of entries written to `meta`.
+     * @param meta An array of at least `maxPackets` elements. Each element
+     * describes the pipe number and length of the payload saved in the
+     * corresponding buffer.
+     * @returns The number of payloads fetched from the RX FIFO.
+     *
+     * @code
+     * uint8_t buffers[3][32];
+     * rf24_rx_meta_t meta[3];
+     * uint8_t count = radio.readAll(buffers, 3, meta);
+     * for (uint8_t i = 0; i < count; ++i) {
+     *   handle(meta[i].pipe, buffers[i], meta[i].length);
+     * }
+     * @endcode
+     * @note The RX FIFO holds at most 3 payloads, but more may be received
+     * while the FIFO is being emptied.
+     */
+    uint8_t readAll(uint8_t (*buffers)[32], uint8_t maxPackets, rf24_rx_meta_t* meta);
+
     /**
      * Be sure to call openWritingPipe() first to set the destination
      * of where to write to.
@@ -644,6 +1016,9 @@ public:
     /**
      * Print a giant block of debugging information to stdout
      *
+     * All registers are read once (with encodeRadioDetails()), so the printed values are
+     * consistent with each other.
+     *
      * @warning Does nothing if stdout is not defined.  See fdevopen in stdio.h
      * The printf.h file is included with the library for Arduino.
      * @code
@@ -673,6 +1048,7 @@ public:
      * understandable without having to look up the datasheet or convert
      * hexadecimal to binary. Only use this function if your application can
      * spare extra bytes of memory.
+     * Like printDetails(), this formats a single snapshot of the registers.
      *
      * @warning Does nothing if stdout is not defined.  See fdevopen in stdio.h
      * The printf.h file is included with the library for Arduino.
@@ -698,6 +1074,7 @@ public:
      * a predefined output stream (like `Serial` or stdout). Only use this function if
      * your application can spare extra bytes of memory. This can also be used for boards that
      * do not support `printf()` (which is required for printDetails() and printPrettyDetails()).
+     * Use sprintfDetails() if the output must be bounded by the buffer size.
      *
      * @remark
      * The C standard function [sprintf()](http://www.cplusplus.com/reference/cstdio/sprintf)
@@ -737,6 +1114,36 @@ public:
      */
     uint16_t sprintfPrettyDetails(char* debugging_information);
 
+    /**
+     * Put the radio details in a char array as structured data (JSON or key/value pairs).
+     *
+     * Unlike sprintfPrettyDetails(), the output is bounded by the given buffer size (like
+     * `snprintf()`), so it is safe to use with a small buffer. The registers are read once
+     * (with encodeRadioDetails()) and formatted with rf24_sprintf_details(); no heap memory is used.
+     *
+     * @code
+     * char buffer[800];
+     * uint16_t length = radio.sprintfDetails(buffer, sizeof(buffer));
+     * if (length < sizeof(buffer)) {
+     *     Serial.println(buffer); // {"ce_pin":7,"csn_pin":8,...}
+     * }
+     * @endcode
+     *
+     * @param buffer The c-string buffer that the details are stored to.
+     * @param size The size of `buffer` (in bytes). The output is truncated to `size - 1`
+     * characters and always null terminated (unless `size` is 0).
+     * @param format The output format; see @ref rf24_details_format_e.
+     * @returns The number of characters that the whole output needs (not including the null
+     * terminating byte). The output was truncated if this is not less than `size`.
+     *
+     * This function is available in the python wrapper, but it only accepts the `format`
+     * parameter and returns a string.
+     * @code{.py}
+     * details = json.loads(radio.sprintfDetails())
+     * @endcode
+     */
+    uint16_t sprintfDetails(char* buffer, uint16_t size, rf24_details_format_e format = RF24_DETAILS_JSON);
+
     /**
      * Encode radio debugging information into an array of uint8_t. This function
      * differs from other debug output methods because the debug information can
@@ -747,15 +1154,17 @@ public:
      *
      * @remark
      * This function uses much less ram than other `*print*Details()` methods.
+     * On drivers that batch SPI transactions, all registers are read with 1 batched transaction.
+     * Use rf24_decode_details() to decode the output.
      *
      * @code
-     * uint8_t encoded_details[43] = {0};
+     * uint8_t encoded_details[RF24_DETAILS_SIZE] = {0};
      * radio.encodeRadioDetails(encoded_details);
      * @endcode
      *
      * @param encoded_status The uint8_t array that RF24 radio details are
-     * encoded into. This array must be at least 43 bytes in length; any less would surely
-     * cause undefined behavior.
+     * encoded into. This array must be at least @ref RF24_DETAILS_SIZE (43) bytes in length;
+     * any less would surely cause undefined behavior.
      *
      * Registers names and/or data corresponding to the index of the `encoded_details` array:
      * | index | register/data |
@@ -786,8 +1195,8 @@ public:
      * | 35 |    FIFO_STATUS |
      * | 36 |    DYNPD |
      * | 37 |    FEATURE |
-     * | 38-39 | ce_pin |
-     * | 40-41 | csn_pin |
+     * | 38-39 | ce_pin (most significant byte first) |
+     * | 40-41 | csn_pin (most significant byte first) |
      * | 42 |    SPI speed (in MHz) or'd with (isPlusVariant << 4) |
      */
     void encodeRadioDetails(uint8_t* encoded_status);
@@ -950,6 +1359,26 @@ public:
      */
     bool write(const void* buf, uint8_t len, const bool multicast);
 
+    /**
+     * Similar to write(const void*, uint8_t, const bool) but the payload is gathered
+     * from several segments (like a header and a body), so they don't have to be
+     * concatenated into a temporary buffer first.
+     *
+     * @param segs An array of segments that are transmitted back to back as 1 payload.
+     * Data beyond the payload size (or 32 bytes with dynamic payloads) is ignored.
+     * @param nsegs The number of segments in the `segs` array.
+     * @param multicast Request ACK response (false), or no ACK response
+     * (true). Be sure to have called enableDynamicAck() at least once before
+     * setting this parameter.
+     * @return Same as write(const void*, uint8_t, const bool).
+     *
+     * @code
+     * rf24_iovec_t segs[2] = {{&sequence, sizeof(sequence)}, {&frame, sizeof(frame)}};
+     * radio.write(segs, 2);
+     * @endcode
+     */
+    bool write(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast = 0);
+
     /**
      * This will not block until the 3 FIFO buffers are filled with data.
      * Once the FIFOs are full, writeFast() will simply wait for a buffer to
@@ -1037,6 +1466,50 @@ public:
      */
     bool writeFast(const void* buf, uint8_t len, const bool multicast);
 
+    /**
+     * Similar to writeFast(const void*, uint8_t, const bool) but the payload is gathered
+     * from several segments.
+     * @see write(const rf24_iovec_t*, uint8_t, const bool)
+     *
+     * @param segs An array of segments that are transmitted back to back as 1 payload.
+     * @param nsegs The number of segments in the `segs` array.
+     * @param multicast Request ACK response (false), or no ACK response (true).
+     * @return Same as writeFast(const void*, uint8_t, const bool).
+     */
+    bool writeFast(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast = 0);
+
+    /**
+     * Transmit a sequence of payloads and report which of them were delivered.
+     *
+     * The TX FIFO is kept full while payloads remain, and the FIFO's occupancy
+     * (read in the same SPI batch that clears the `TX_DS` flag) tells how many
+     * payloads were sent. The radio is only polled with update() while no
+     * payload can be loaded into the TX FIFO.
+     *
+     * Any payloads left in the TX FIFO are discarded first. The radio is left in
+     * STANDBY-I mode with an empty TX FIFO.
+     *
+     * @param bufs An array of `n` pointers to the payloads' data.
+     * @param lens An array of `n` payload lengths (in bytes).
+     * @param n The number of payloads to transmit.
+     * @param multicast Request ACK responses (false), or no ACK responses
+     * (true). Be sure to have called enableDynamicAck() at least once before
+     * setting this parameter.
+     * @param ackedBitmap An array of at least `(n + 31) / 32` words (or `nullptr`).
+     * Bit `i % 32` of word `i / 32` is set if payload `i` was delivered.
+     * @param policy What to do with a payload that was not acknowledged after all
+     * of its automatic retries. See @ref rf24_tx_fail_e.
+     * @returns The number of payloads delivered.
+     *
+     * @code
+     * const void* bufs[3] = {&a, &b, &c};
+     * uint8_t lens[3] = {sizeof(a), sizeof(b), sizeof(c)};
+     * uint32_t acked;
+     * size_t delivered = radio.writeMany(bufs, lens, 3, false, &acked, RF24_TX_RETRY);
+     * @endcode
+     */
+    size_t writeMany(const void* const* bufs, const uint8_t* lens, size_t n, bool multicast, uint32_t* ackedBitmap, rf24_tx_fail_e policy = RF24_TX_SKIP);
+
     /**
      * This function extends the auto-retry mechanism to any specified duration.
      * It will not block until the 3 FIFO buffers are filled with data.
@@ -1226,6 +1699,122 @@ public:
      */
     void setStatusFlags(uint8_t flags = RF24_IRQ_NONE);
 
+#if defined(RF24_IRQ_WAIT) || defined(DOXYGEN_FORCED)
+    /**
+     * Sleep on the radio's IRQ pin instead of busy polling the radio.
+     *
+     * By default, write(), writeFast(), writeBlocking() and txStandBy() continuously
+     * query the radio's STATUS (or FIFO_STATUS) register until the transmission
+     * completes. After calling this function, those functions instead sleep until the
+     * radio's IRQ pin is asserted (or the function's timeout expires).
+     *
+     * The radio's IRQ pin only reflects the events enabled with setStatusFlags().
+     * If the awaited events (`RF24_TX_DS` and `RF24_TX_DF`) are not both enabled,
+     * then the radio is polled as usual.
+     *
+     * @param pin The GPIO pin connected to the radio's IRQ pin. Use `RF24_PIN_INVALID`
+     * to return to busy polling.
+     *
+     * @note The STATUS flags are not cleared while waiting. If an event (like
+     * `RF24_RX_DR` or an earlier `RF24_TX_DS`) still asserts the IRQ pin, the radio is
+     * polled until that event is cleared (with clearStatusFlags() or whatHappened()).
+     * @note This function is only available with the SPIDEV driver. An interrupt
+     * handler can still be attached to the same pin with attachInterrupt().
+     * @note The falling edges of the IRQ pin are also used to timestamp received
+     * payloads (see rf24_rx_meta_t::timestamp) and finished transmissions (see
+     * getTxRecord()).
+     *
+     * @ingroup StatusFlags
+     */
+    void setIrqPin(rf24_gpio_pin_t pin);
+#endif // defined(RF24_IRQ_WAIT) || defined(DOXYGEN_FORCED)
+
+#if defined(RF24_IRQ_CONTEXT) || defined(DOXYGEN_FORCED)
+    /**
+     * Handle the radio's IRQ pin with this object's own interrupt handler.
+     *
+     * Every falling edge of the IRQ pin is routed into the radio's status processing:
+     * the STATUS byte is fetched once (so getStatusFlags() is up to date), a received
+     * payload is timestamped with the kernel's time of the edge (see
+     * rf24_rx_meta_t::timestamp), and then the optional @p handler is called with the
+     * asserted event flags. Edges that are detected together (because the dispatcher
+     * was busy) are handled as one, with 1 STATUS read and 1 call of the @p handler. So the handler doesn't need to call update() to learn
+     * which event occurred, and no global RF24 object is needed to reach the radio.
+     * @code
+     * void onIrq(void* context, uint8_t flags)
+     * {
+     *     RF24* radio = static_cast<RF24*>(context);
+     *     if (flags & RF24_RX_DR) {
+     *         // radio->read(...)
+     *     }
+     *     radio->clearStatusFlags(flags);
+     * }
+     * radio.attachIrq(IRQ_PIN, onIrq, &radio);
+     * @endcode
+     *
+     * @param pin The GPIO pin connected to the radio's IRQ pin.
+     * @param handler A function to call with the @p context and the asserted flags (a
+     * combination of @ref rf24_irq_flags_e values). The flags are not cleared, so the
+     * handler (or the program) should handle the events and clear them (like with
+     * clearStatusFlags()) to let the IRQ pin signal the next event.
+     * @param context An arbitrary pointer passed to the @p handler.
+     * @returns `true` if the pin is handled, `false` otherwise.
+     *
+     * @note The handler is called from the interrupt dispatcher's thread. The radio's SPI
+     * transactions (and batches) are serialized with the other threads', so the handler can
+     * use the radio while another thread does. The handler itself doesn't block the other
+     * threads; only its own SPI transactions do. But events handled (and cleared) by the
+     * handler are not seen by blocking functions running in another thread, like write()
+     * waiting for `RF24_TX_DS`.
+     * @note This function is only available with the SPIDEV and Virtual drivers.
+     *
+     * @ingroup StatusFlags
+     */
+    bool attachIrq(rf24_gpio_pin_t pin, void (*handler)(void* context, uint8_t flags) = nullptr, void* context = nullptr);
+
+    /**
+     * Stop handling the IRQ pin passed to attachIrq().
+     * @ingroup StatusFlags
+     */
+    void detachIrq();
+#endif // defined(RF24_IRQ_CONTEXT) || defined(DOXYGEN_FORCED)
+
+#if defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+    /**
+     * Get the timing and outcome of the last payload transmitted with write().
+     *
+     * The difference between `end` and `start` includes the PLL settling time, the
+     * time on air and any automatic retries.
+     * @code
+     * radio.write(&data, sizeof(data));
+     * rf24_tx_record_t record = radio.getTxRecord();
+     * uint64_t airTime = record.end - record.start; // in nanoseconds
+     * @endcode
+     * @note This function is only available on Linux.
+     */
+    rf24_tx_record_t getTxRecord();
+#endif
+
+#if defined(RF24_LINK_STATS) || defined(DOXYGEN_FORCED)
+    /**
+     * Get a snapshot of the link statistics counted since begin() (or resetLinkStats()).
+     *
+     * This does not perform any SPI transaction with the radio.
+     * @code
+     * rf24_link_stats_t stats = radio.getLinkStats();
+     * printf("%u of %u payloads acked\n", stats.acked, stats.sent);
+     * @endcode
+     * @note This function is only available when `RF24_LINK_STATS` is defined (always the case on Linux).
+     */
+    rf24_link_stats_t getLinkStats();
+
+    /**
+     * Set every link statistic counter back to `0`.
+     * @note This function is only available when `RF24_LINK_STATS` is defined (always the case on Linux).
+     */
+    void resetLinkStats();
+#endif
+
     /**
      * Get the latest STATUS byte returned from the last SPI transaction.
      *
@@ -1290,6 +1879,18 @@ public:
      */
     void startFastWrite(const void* buf, uint8_t len, const bool multicast, bool startTx = 1);
 
+    /**
+     * Similar to startFastWrite(const void*, uint8_t, const bool, bool) but the payload
+     * is gathered from several segments.
+     * @see write(const rf24_iovec_t*, uint8_t, const bool)
+     *
+     * @param segs An array of segments that are transmitted back to back as 1 payload.
+     * @param nsegs The number of segments in the `segs` array.
+     * @param multicast Request ACK response (false), or no ACK response (true).
+     * @param startTx Set the CE pin active (`true`) or just load the payload (`false`).
+     */
+    void startFastWrite(const rf24_iovec_t* segs, uint8_t nsegs, const bool multicast, bool startTx = 1);
+
     /**
      * Non-blocking write to the open writing pipe
      *
@@ -1403,6 +2004,73 @@ public:
      */
     bool testRPD(void);
 
+    /**
+     * Sample the Received Power Detector on a range of channels.
+     *
+     * The radio stays in RX mode for the whole scan. Each hop only toggles the CE pin
+     * and writes the RF_CH register, and the RPD sample of the previous channel is read
+     * in the same SPI transaction (on drivers that batch SPI transactions). None of the
+     * TX-side housekeeping of stopListening() is done between channels.
+     *
+     * @code
+     * uint16_t hits[126] = {0};
+     * radio.scanChannels(0, 125, 170, 100, hits); // 100 sweeps of the whole band
+     * @endcode
+     *
+     * @param first The first channel to scan.
+     * @param last The last channel to scan (clamped to 125).
+     * @param dwell_us The time (in microseconds) spent listening on each channel.
+     * This is raised to 170 µs if needed: the RPD is only valid 130 µs (RX settling)
+     * + 40 µs (AGC delay) after entering RX mode.
+     * @param reps The number of sweeps over the channels.
+     * @param hits An array of `last - first + 1` counters. The counter of each
+     * channel is incremented (not reset) once per sweep that detected a signal
+     * greater than or equal to -64dBm.
+     *
+     * @note The radio is left on the channel it used before the scan. If the radio
+     * was not listening before the scan, then it is returned to TX mode with
+     * stopListening(). Any payloads received during the scan are discarded.
+     * @warning This is only supported on nRF24L01+ hardware (see testRPD()) and
+     * needs a dedicated CE pin.
+     */
+    void scanChannels(uint8_t first, uint8_t last, uint16_t dwell_us, uint16_t reps, uint16_t* hits);
+
+    /**
+     * Find the channel with the least activity and use it.
+     *
+     * This builds an occupancy histogram with scanChannels() and ranks the specified
+     * channels by it. At @ref RF24_2MBPS, a transmission occupies 2 MHz, so half of the
+     * activity detected on each adjacent channel is added to a channel's occupancy.
+     *
+     * @code
+     * // pick the quietest channel above the Wi-Fi channels 1, 6 and 11
+     * uint8_t candidates[] = {76, 80, 90, 100, 110, 120};
+     * uint8_t ranked[sizeof(candidates)];
+     * uint16_t occupancy[sizeof(candidates)];
+     * radio.selectQuietChannel(candidates, sizeof(candidates), 100, ranked, occupancy);
+     * @endcode
+     *
+     * @param channels The channels to choose from. If this is `nullptr`, then the
+     * channels `0` to `count - 1` are used.
+     * @param count The number of channels to choose from.
+     * @param passes The number of sweeps over the channels (each listening 170 µs on a channel).
+     * @param ranked An optional array of `count` elements that receives the channels
+     * sorted from the quietest to the busiest. Channels of equal occupancy keep the
+     * order of `channels`.
+     * @param occupancy An optional array of `count` elements that receives the
+     * occupancy score of each channel in `ranked`. This is the number of passes that
+     * detected a signal greater than or equal to -64dBm on the channel. At @ref RF24_2MBPS,
+     * half of the detections on each adjacent channel are added, so the score can exceed
+     * `passes` (up to twice `passes`). This is only filled if `ranked` is given.
+     * @returns The quietest channel, which is also passed to setChannel().
+     * Returns the current channel if `count` is 0.
+     *
+     * @note Both ends of a link must use the same channel, so only the node that
+     * decides the channel of a network should use this.
+     * @warning This is only supported on nRF24L01+ hardware (see testRPD()).
+     */
+    uint8_t selectQuietChannel(const uint8_t* channels, uint8_t count, uint16_t passes = 100, uint8_t* ranked = nullptr, uint16_t* occupancy = nullptr);
+
     /**
      * Test whether this is a real radio, or a mock shim for
      * debugging.  Setting either pin to 0xff is the way to
@@ -1420,6 +2088,23 @@ public:
      */
     void closeReadingPipe(uint8_t pipe);
 
+#if defined(RF24_SHADOW_REGISTERS) || defined(DOXYGEN_FORCED)
+    /**
+     * Refresh the cached copy of the radio's configuration registers.
+     *
+     * When `RF24_SHADOW_REGISTERS` is defined, the configuration registers
+     * (RF_SETUP, EN_AA, EN_RXADDR, FEATURE, DYNPD, SETUP_RETR, RF_CH,
+     * SETUP_AW and RX_PW_P0 - RX_PW_P5) are mirrored in RAM. Getters are then
+     * served from the cache and setters only need to write the register.
+     *
+     * If the radio loses power (or is otherwise reset) without calling begin(),
+     * the cache no longer reflects the radio's configuration. Use this function
+     * to read every cached register from the radio again.
+     * @note This function is only available when `RF24_SHADOW_REGISTERS` is defined.
+     */
+    void resyncShadow();
+#endif // defined(RF24_SHADOW_REGISTERS) || defined(DOXYGEN_FORCED)
+
 #if defined(FAILURE_HANDLING)
     /**
      *
@@ -1440,6 +2125,7 @@ public:
      *     - Fixed by monitoring a value that is different from the default, and re-configuring the radio if this setting reverts to the default.
      *
      * See the included example, GettingStarted_HandlingFailures
+     * On Linux, setAutoRecover() can re-configure the radio automatically.
      *
      * @code
      * if(radio.failureDetected) {
@@ -1454,6 +2140,57 @@ public:
     bool failureDetected;
 #endif // defined (FAILURE_HANDLING)
 
+#if defined(FAILURE_HANDLING) || defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+    /**
+     * Set how long write(), writeFast(), writeBlocking(), writeMany() and txStandBy() wait
+     * for the radio (beyond their own timeout) before considering it unresponsive.
+     *
+     * When this time expires, the function reports a `RF24_ERR_TIMEOUT` failure (see
+     * getLastError() and setErrorHandler()) and returns immediately.
+     * @param timeout The time (in milliseconds). The default is `RF24_HARDWARE_TIMEOUT` (95 ms).
+     * A transmission with the maximum auto-retry delay and count takes about 70 ms.
+     */
+    void setHardwareTimeout(uint16_t timeout);
+
+    /**
+     * @returns The last failure reported (`RF24_ERR_NONE` if no failure was reported).
+     * @see setErrorHandler()
+     */
+    rf24_error_e getLastError();
+
+    /**
+     * Set a function to call when a failure is detected, instead of printing a message.
+     * @code
+     * void onRadioError(void* context, rf24_error_e error)
+     * {
+     *     static_cast<Gateway*>(context)->radioFailed(error);
+     * }
+     * radio.setErrorHandler(onRadioError, &gateway);
+     * @endcode
+     * @param handler The function to call (from the function that detected the failure),
+     * or `nullptr` to only record the failure.
+     * @param context An arbitrary pointer passed to the @p handler.
+     */
+    void setErrorHandler(void (*handler)(void* context, rf24_error_e error), void* context = nullptr);
+#endif // defined(FAILURE_HANDLING) || defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+
+#if defined(RF24_LINUX) || defined(DOXYGEN_FORCED)
+    /**
+     * Initialize the radio again automatically after a failure, restoring its configuration.
+     *
+     * When enabled, the configuration registers (including the addresses of pipes 0 & 1 and
+     * the TX address) are read once and then kept up to date as they are written. After a
+     * `RF24_ERR_TIMEOUT` failure, the radio is initialized like begin() does and the
+     * configuration is written back. Then a `RF24_ERR_RECOVERED` (or
+     * `RF24_ERR_RECOVERY_FAILED`) failure is reported. The payloads in the FIFOs are lost.
+     * @param enable `true` to recover automatically, `false` to only report failures (the default).
+     * Without recovery, CE is set LOW and the TX FIFO is flushed after a failure, so the
+     * failed transmission doesn't continue in the background.
+     * @note This function is only available on Linux.
+     */
+    void setAutoRecover(bool enable);
+#endif
+
     /**@}*/
     /**
      * @name Optional Configurators
@@ -2113,6 +2850,18 @@ private:
      */
     void write_payload(const void* buf, uint8_t len, const uint8_t writeType);
 
+    /**
+     * Write the transmit payload gathered from several segments
+     *
+     * On drivers that can transmit several buffers as 1 SPI frame (`SPI_HAS_GATHER`),
+     * the segments are not copied at all.
+     *
+     * @param segs The segments of the payload
+     * @param nsegs Number of segments in @p segs
+     * @param writeType Specify if individual payload should be acknowledged
+     */
+    void write_payload(const rf24_iovec_t* segs, uint8_t nsegs, const uint8_t writeType);
+
     /**
      * Read the receive payload
      *
@@ -2125,6 +2874,24 @@ private:
      */
     void read_payload(void* buf, uint8_t len);
 
+#if defined(RF24_SPI_BATCH)
+    /**
+     * Append a frame to the queue of a batched SPI transaction
+     *
+     * @param command The command byte. Use constants from nRF24L01.h
+     * @param buf Where to get the data (can be `nullptr` if @p len is `0`)
+     * @param len How many bytes of data to transfer after the command byte
+     */
+    void batch_queue(uint8_t command, const uint8_t* buf, uint8_t len);
+
+    /**
+     * Transfer all queued frames of a batched SPI transaction
+     *
+     * The status byte is updated from the last frame transferred.
+     */
+    void batch_flush();
+#endif
+
 #if !defined(MINIMAL)
 
     /**
@@ -2144,10 +2911,10 @@ private:
      * of related registers on one line.
      *
      * @param name Name of the register
-     * @param reg Which register. Use constants from nRF24L01.h
+     * @param values The register values (from a snapshot taken with encodeRadioDetails())
      * @param qty How many successive registers to print
      */
-    void print_byte_register(const char* name, uint8_t reg, uint8_t qty = 1);
+    void print_byte_register(const char* name, const uint8_t* values, uint8_t qty = 1);
 
     /**
      * Print the name and value of a 40-bit address register to stdout
@@ -2157,24 +2924,20 @@ private:
      * of related registers on one line.
      *
      * @param name Name of the register
-     * @param reg Which register. Use constants from nRF24L01.h
+     * @param addresses The addresses (from a snapshot taken with encodeRadioDetails(),
+     * which holds 5 bytes per address)
      * @param qty How many successive registers to print
      */
-    void print_address_register(const char* name, uint8_t reg, uint8_t qty = 1);
+    void print_address_register(const char* name, const uint8_t* addresses, uint8_t qty = 1);
 
     /**
      * Put the value of a 40-bit address register into a char array
      *
-     * Optionally it can print some quantity of successive
-     * registers on the same line.  This is useful for printing a group
-     * of related registers on one line.
-     *
      * @param out_buffer Output buffer, char array
-     * @param reg Which register. Use constants from nRF24L01.h
-     * @param qty How many successive registers to print
+     * @param address The address (least significant byte first)
      * @return The total number of characters written to the given buffer.
      */
-    uint8_t sprintf_address_register(char* out_buffer, uint8_t reg, uint8_t qty = 1);
+    uint8_t sprintf_address_register(char* out_buffer, const uint8_t* address);
 #endif
 
     /**
@@ -2185,10 +2948,90 @@ private:
      */
     void toggle_features(void);
 
+    /**
+     * Forget the cached value of a register, so that the next read_register()
+     * fetches the value from the radio.
+     * This does nothing unless `RF24_SHADOW_REGISTERS` is defined.
+     *
+     * @param reg Which register to forget
+     */
+    void shadow_discard(uint8_t reg);
+
 #if defined(FAILURE_HANDLING) || defined(RF24_LINUX)
 
     void errNotify(void);
 
+    /** Record a failure and pass it to the handler set with setErrorHandler(). */
+    void report_error(rf24_error_e error);
+
+#endif
+
+#if defined(RF24_LINUX)
+    /**
+     * Remember the value written to a register that setAutoRecover() restores.
+     * @param reg The register's address.
+     * @param buf The written value.
+     * @param len The number of bytes written.
+     */
+    void recover_track(uint8_t reg, const uint8_t* buf, uint8_t len);
+
+    /**
+     * Initialize the radio again and restore the configuration kept for setAutoRecover().
+     * @returns `true` if the radio responded, `false` otherwise.
+     */
+    bool recover();
+#endif
+
+#if defined(RF24_IRQ_WAIT)
+    /**
+     * Sleep until the radio's IRQ pin is asserted by one of the specified `flags`.
+     *
+     * If the IRQ pin is not configured (or the `flags` are masked), or the IRQ pin is
+     * already asserted, this returns immediately so the caller keeps polling. The
+     * STATUS flags are never cleared on the caller's behalf.
+     *
+     * @param flags The events to wait for.
+     * @param deadline The value of millis() at which to stop waiting.
+     */
+    void wait_irq(uint8_t flags, uint32_t deadline);
+#endif
+
+    /**
+     * @returns `true` if the RX_ADDR_P0 register has to be written to hold the
+     * given cached address (`pipe0_reading_address` or `pipe0_writing_address`).
+     * @param content The cached address needed in the register.
+     */
+    bool pipe0_outdated(uint8_t content);
+
+    /** Remember when a received payload was last handled (see setFastTurnaround()). */
+    void rx_handled();
+
+#if defined(RF24_LINUX)
+    /**
+     * @returns The time of an event (in nanoseconds of `CLOCK_MONOTONIC`): the IRQ pin's
+     * latest falling edge if it occurred after @p since, otherwise the current time.
+     */
+    uint64_t event_time(uint64_t since);
+#endif
+
+#if defined(RF24_IRQ_CONTEXT)
+    /**
+     * The interrupt handler used by attachIrq().
+     * @param context The RF24 object that handles the IRQ pin.
+     * @param event The details of the IRQ pin's falling edge.
+     */
+    static void irq_event(void* context, const rf24_irq_event& event);
+#endif
+
+#if defined(RF24_LINK_STATS)
+    /** Count the pending payloads as delivered if `RF24_TX_DS` is asserted (the TX FIFO was found empty). */
+    void count_tx_acked();
+
+    /**
+     * Accumulate the link statistics from an OBSERVE_TX register value.
+     * @param value The OBSERVE_TX register's value after a payload was transmitted.
+     */
+    void count_observe_tx(uint8_t value);
 #endif
 
     /**
@@ -2211,6 +3054,36 @@ private:
     /**@}*/
 };
 
+/**
+ * Decode the output of RF24::encodeRadioDetails().
+ *
+ * This needs no radio hardware, so it can be used to check the details logged by other
+ * nodes (see the decodeDetails example for Linux).
+ *
+ * @param encoded_details The @ref RF24_DETAILS_SIZE bytes written by RF24::encodeRadioDetails().
+ * @param details The decoded details.
+ * @returns false if the registers hold values that a responding radio cannot have
+ * (like all bits set or cleared, as read from a disconnected radio). `details` is filled either way.
+ */
+bool rf24_decode_details(const uint8_t* encoded_details, rf24_details_t* details);
+
+/**
+ * Format decoded radio details as structured data (JSON or key/value pairs).
+ *
+ * The keys match the columns of the decodeDetails example for Linux. Addresses are
+ * hexadecimal strings (most significant byte first) and the FIFO_STATUS, IRQ and pipe
+ * bit fields are hexadecimal strings like `"0x3F"`.
+ *
+ * @param details The details decoded by rf24_decode_details().
+ * @param buffer The c-string buffer that the details are stored to.
+ * @param size The size of `buffer` (in bytes). The output is truncated to `size - 1`
+ * characters and always null terminated (unless `size` is 0).
+ * @param format The output format; see @ref rf24_details_format_e.
+ * @returns The number of characters that the whole output needs (not including the null
+ * terminating byte), like `snprintf()`.
+ */
+uint16_t rf24_sprintf_details(const rf24_details_t* details, char* buffer, uint16_t size, rf24_details_format_e format);
+
 /**
  * @example{lineno} examples/GettingStarted/GettingStarted.ino
  * Written by [2bndy5](http://github.com/2bndy5) in 2020
@@ -23,6 +23,8 @@
 #define FAILURE_HANDLING
 //#define RF24_DEBUG
 //#define MINIMAL
+//#define RF24_SHADOW_REGISTERS // Cache configuration registers in RAM (costs 16 bytes per instance)
+//#define RF24_LINK_STATS       // Count link statistics in RAM (costs 68 bytes per instance, always defined on Linux)
 //#define SPI_UART    // Requires library from https://github.com/TMRh20/Sketches/tree/master/SPI_UART
 //#define SOFTSPI     // Requires library from https://github.com/greiman/DigitalIO
 
@@ -36,6 +38,11 @@
 #endif
 
 /**********************/
+#if defined(RF24_SHADOW_REGISTERS)
+    /** @brief The number of configuration registers cached by RF24 */
+    #define RF24_SHADOW_SIZE 14
+#endif
+
 #define rf24_max(a, b) ((a) > (b) ? (a) : (b))
 #define rf24_min(a, b) ((a) < (b) ? (a) : (b))
 
@@ -241,4 +248,9 @@ typedef uint16_t prog_uint16_t;
     #define RF24_SPI_TRANSACTIONS
 #endif // defined (SPI_HAS_TRANSACTION) && !defined (SPI_UART) && !defined (SOFTSPI)
 
+#if defined(RF24_LINUX) && !defined(RF24_LINK_STATS)
+    // Linux hosts can spare the RAM, so link statistics are always counted
+    #define RF24_LINK_STATS
+#endif
+
 #endif // RF24_CONFIG_H_
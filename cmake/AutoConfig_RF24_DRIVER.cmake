@@ -6,7 +6,8 @@ set(RF24_DRIVER "UNKNOWN" CACHE STRING "override automatic configuration of RF24
     SPIDEV
     MRAA
     LittleWire
-    pigpio"
+    pigpio
+    Virtual (emulated radios for testing without hardware)"
 )
 
 ###########################
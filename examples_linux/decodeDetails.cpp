@@ -0,0 +1,199 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * Decode radio details dumped by RF24::encodeRadioDetails() into CSV.
+ *
+ * Every input line holds the 43 encoded bytes as hexadecimal numbers separated by spaces
+ * (like the output of the encodeRadioDetails example for Arduino). Each line is decoded
+ * with rf24_decode_details() into a CSV row. Lines that don't hold 43 bytes are reported
+ * on stderr and skipped. The `valid` column is 0 if the registers could not have been
+ * read from a responding radio.
+ *
+ * With the `-j` option, each line is decoded into a JSON object (formatted with
+ * rf24_sprintf_details()) instead, with the same keys as the CSV columns.
+ *
+ * With the `-t` option, nothing is decoded. Instead, the SPI speed and model byte is checked
+ * to survive an encode/decode round trip for both models. If the CE and CSN pins of a connected
+ * radio are also given, the details encoded by that radio are checked too.
+ *
+ * Usage: decodeDetails [-j] [<log file>...] > details.csv
+ * (stdin is read if no file is given)
+ *        decodeDetails -t [<ce pin> <csn pin>]
+ */
+#include <stdio.h>  // fopen(), fgets(), printf(), fprintf(), setvbuf()
+#include <string.h> // strerror(), strcmp()
+#include <errno.h>  // errno
+#include <stdlib.h> // atoi()
+#include <RF24/RF24.h>
+
+// parse hexadecimal numbers separated by any other characters; returns the number of bytes found
+static size_t parse_hex(const char* line, uint8_t* buf, size_t size)
+{
+    size_t count = 0;
+    int value = -1; // -1 while not in a number
+    for (const char* c = line;; ++c) {
+        int digit = -1;
+        if (*c >= '0' && *c <= '9') {
+            digit = *c - '0';
+        }
+        else if ((*c | 0x20) >= 'a' && (*c | 0x20) <= 'f') {
+            digit = (*c | 0x20) - 'a' + 10;
+        }
+        else if ((*c | 0x20) == 'x' && value == 0) {
+            value = -1; // skip a "0x" prefix
+            continue;
+        }
+        if (digit >= 0) {
+            value = (value < 0 ? 0 : value << 4) | digit;
+            continue;
+        }
+        if (value >= 0) {
+            if (count == size || value > 0xFF) {
+                return size + 1; // too many bytes (or not a byte)
+            }
+            buf[count++] = static_cast<uint8_t>(value);
+            value = -1;
+        }
+        if (!*c) {
+            return count;
+        }
+    }
+}
+
+// print an address with its most significant byte first
+static void print_address(const uint8_t* address, uint8_t width)
+{
+    putchar(',');
+    while (width--) {
+        printf("%02X", address[width]);
+    }
+}
+
+static void decode(FILE* input, const char* name, bool json, unsigned long long& decoded)
+{
+    const unsigned kbps[] = {1000, 2000, 250}; // the values of rf24_datarate_e
+    char line[512];
+    unsigned long number = 0;
+    while (fgets(line, sizeof(line), input)) {
+        ++number;
+        uint8_t encoded[RF24_DETAILS_SIZE];
+        size_t count = parse_hex(line, encoded, sizeof(encoded));
+        if (count != RF24_DETAILS_SIZE) {
+            if (count) { // blank lines are silently ignored
+                fprintf(stderr, "%s:%lu: expected %d bytes\n", name, number, RF24_DETAILS_SIZE);
+            }
+            continue;
+        }
+
+        rf24_details_t details;
+        bool valid = rf24_decode_details(encoded, &details);
+        if (json) {
+            char object[1024];
+            rf24_sprintf_details(&details, object, sizeof(object), RF24_DETAILS_JSON);
+            // insert the fields that aren't part of the radio details
+            printf("{\"source\":\"%s\",\"line\":%lu,\"valid\":%s,%s\n", name, number, valid ? "true" : "false", object + 1);
+            ++decoded;
+            continue;
+        }
+        printf("%s,%lu,%d,%u,%u,%u,%d,%u,%u,%d,%d,%u,%u,%u,%u,0x%02X,0x%02X,0x%02X,%d,%d,%d,%d,%d,0x%02X,0x%02X,0x%02X,%u,%u,%d",
+               name, number, valid, details.cePin, details.csnPin, details.spiSpeed, details.isPVariant,
+               details.channel, kbps[details.dataRate], details.paLevel, details.lnaEnabled,
+               details.crcLength ? details.crcLength * 8 : 0, details.addressWidth, details.retryDelay, details.retryCount,
+               details.autoAck, details.dynamicPayloads, details.openPipes,
+               details.dynamicPayloadsFeature, details.ackPayloads, details.dynamicAck, details.powerUp, details.primaryRx,
+               details.irqMasked, details.irqFlags, details.fifoStatus, details.lostPackets, details.retries, details.rpd);
+        print_address(details.txAddress, details.addressWidth);
+        for (uint8_t i = 0; i < 6; ++i) {
+            print_address(details.pipeAddress[i], details.addressWidth);
+        }
+        for (uint8_t i = 0; i < 6; ++i) {
+            printf(",%u", details.payloadSize[i]);
+        }
+        putchar('\n');
+        ++decoded;
+    }
+}
+
+// check that the SPI speed and the model survive a round trip through rf24_decode_details()
+static bool check_round_trip(const uint8_t* encoded, uint8_t spi_mhz, bool plus)
+{
+    rf24_details_t details;
+    rf24_decode_details(encoded, &details);
+    if (details.spiSpeed != spi_mhz || details.isPVariant != plus) {
+        fprintf(stderr, "%s @ %u MHz decoded as %s @ %u MHz\n", plus ? "nRF24L01+" : "nRF24L01", spi_mhz,
+                details.isPVariant ? "nRF24L01+" : "nRF24L01", details.spiSpeed);
+        return false;
+    }
+    return true;
+}
+
+static int self_test(int argc, char** argv)
+{
+    unsigned failed = 0, checked = 0;
+    uint8_t encoded[RF24_DETAILS_SIZE] = {0};
+    for (uint8_t plus = 0; plus < 2; ++plus) {
+        for (uint8_t spi_mhz = 1; spi_mhz < 16; ++spi_mhz) {
+            // the last byte written by RF24::encodeRadioDetails()
+            encoded[RF24_DETAILS_SIZE - 1] = static_cast<uint8_t>(spi_mhz | plus << 4);
+            failed += !check_round_trip(encoded, spi_mhz, plus);
+            ++checked;
+        }
+    }
+
+    if (argc > 3) {
+        RF24 radio(static_cast<rf24_gpio_pin_t>(atoi(argv[2])), static_cast<rf24_gpio_pin_t>(atoi(argv[3])));
+        if (!radio.begin()) {
+            fprintf(stderr, "radio hardware is not responding!!\n");
+            return 1;
+        }
+        radio.encodeRadioDetails(encoded);
+        failed += !check_round_trip(encoded, RF24_SPI_SPEED / 1000000, radio.isPVariant());
+        ++checked;
+    }
+    fprintf(stderr, "%u of %u round trips failed\n", failed, checked);
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+        return self_test(argc, argv);
+    }
+
+    static char buffer[1 << 16];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer)); // stdout is only flushed when the buffer is full
+
+    bool json = argc > 1 && strcmp(argv[1], "-j") == 0;
+    if (json) {
+        --argc;
+        ++argv;
+    }
+    else {
+        printf("source,line,valid,ce_pin,csn_pin,spi_mhz,plus_variant,channel,data_rate_kbps,pa_level,lna,crc_bits,"
+               "address_width,retry_delay_us,retry_count,auto_ack,dynamic_payloads,open_pipes,dynamic_payloads_feature,"
+               "ack_payloads,dynamic_ack,power_up,primary_rx,irq_masked,irq_flags,fifo_status,lost_packets,retries,rpd,"
+               "tx_address,pipe0_address,pipe1_address,pipe2_address,pipe3_address,pipe4_address,pipe5_address,"
+               "pipe0_size,pipe1_size,pipe2_size,pipe3_size,pipe4_size,pipe5_size\n");
+    }
+
+    unsigned long long decoded = 0;
+    if (argc < 2) {
+        decode(stdin, "stdin", json, decoded);
+    }
+    for (int i = 1; i < argc; ++i) {
+        FILE* input = fopen(argv[i], "r");
+        if (!input) {
+            fprintf(stderr, "Can't open %s; %s\n", argv[i], strerror(errno));
+            return 1;
+        }
+        decode(input, argv[i], json, decoded);
+        fclose(input);
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "%llu radio details decoded\n", decoded);
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * This program measures the CPU usage and wake-up latency of the thread that
+ * handles the nRF24L01's IRQ pin (as used by attachInterrupt()).
+ *
+ * No other radio is needed. The radio repeatedly transmits to an address that
+ * nobody listens to, so every transmission ends with a "data failed" event on
+ * the IRQ pin once the auto-retries are exhausted.
+ *
+ * Usage: irq_benchmark [seconds] [latency budget in microseconds]
+ * The latency budget only applies if the interrupt backend polls the pin.
+ */
+#include <cstdlib>     // atoi()
+#include <iostream>    // cout, endl
+#include <time.h>      // clock_gettime(), nanosleep()
+#include <RF24/RF24.h> // RF24, attachInterrupt(), INT_EDGE_FALLING
+
+using namespace std;
+
+#define IRQ_PIN 24 // GPIO24
+#define CE_PIN  22
+#define CSN_PIN 0
+
+RF24 radio(CE_PIN, CSN_PIN);
+
+volatile bool got_interrupt = false; // set by the interrupt handler
+
+void interruptHandler()
+{
+    got_interrupt = true;
+}
+
+uint64_t now_ns(clockid_t clock)
+{
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+int main(int argc, char** argv)
+{
+#if defined(IRQ_HAS_STATS)
+    uint32_t seconds = argc > 1 ? atoi(argv[1]) : 10;
+    if (argc > 2) {
+        setInterruptLatency(atoi(argv[2]));
+    }
+
+    if (!radio.begin()) {
+        cout << "radio hardware is not responding!!" << endl;
+        return 0; // quit now
+    }
+    uint8_t address[5] = {0xE7, 0xE7, 0xE7, 0xE7, 0x42};
+    radio.openWritingPipe(address);
+    radio.setRetries(1, 1);                // fail quickly
+    radio.setStatusFlags(RF24_TX_DF);      // only assert the IRQ pin when transmissions fail
+    radio.stopListening();
+
+    attachInterrupt(IRQ_PIN, INT_EDGE_FALLING, &interruptHandler);
+
+    uint8_t payload[4] = {0};
+    uint64_t start = now_ns(CLOCK_MONOTONIC);
+    uint64_t startCpu = now_ns(CLOCK_PROCESS_CPUTIME_ID);
+    timespec pause = {0, 100000}; // 100 us
+    while (now_ns(CLOCK_MONOTONIC) - start < seconds * 1000000000ULL) {
+        got_interrupt = false;
+        radio.startWrite(payload, sizeof(payload), false);
+        while (!got_interrupt && now_ns(CLOCK_MONOTONIC) - start < seconds * 1000000000ULL) {
+            nanosleep(&pause, NULL);
+        }
+        radio.ce(LOW);
+        radio.clearStatusFlags();
+        radio.flush_tx();
+    }
+    uint64_t elapsed = now_ns(CLOCK_MONOTONIC) - start;
+    uint64_t processCpu = now_ns(CLOCK_PROCESS_CPUTIME_ID) - startCpu;
+
+    IrqPinStats stats;
+    getInterruptStats(IRQ_PIN, &stats);
+    detachInterrupt(IRQ_PIN);
+    radio.powerDown();
+
+    cout << "IRQ thread waits on " << (stats.eventDriven ? "GPIO line events" : "Event Detect Status polling") << endl;
+    cout << "events handled:      " << stats.events << endl;
+    if (stats.events) {
+        cout << "average latency:     " << stats.latencyTotal / stats.events / 1000.0 << " us" << endl;
+        cout << "worst latency:       " << stats.latencyMax / 1000.0 << " us" << endl;
+    }
+    cout << "IRQ thread CPU usage: " << 100.0 * stats.cpuTime / stats.wallTime << " %" << endl;
+    cout << "process CPU usage:    " << 100.0 * processCpu / elapsed << " %" << endl;
+#else
+    (void)argc;
+    (void)argv;
+    cout << "This driver's interrupt backend does not provide statistics." << endl;
+#endif
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * An example of streaming data through a software TX queue and RX ring.
+ *
+ * The TX node only copies its payloads into the queue. The queue's worker thread keeps
+ * the radio's TX FIFO fed and reports the outcome of each payload with a callback.
+ * The RX node receives with a background service (RF24RxService). Its worker thread keeps
+ * the radio's RX FIFO drained into a ring that the main thread reads from.
+ *
+ * This example was written to be used on 2 devices acting as "nodes".
+ * It can also be run as 2 processes with the Virtual driver (no hardware needed).
+ * Use `ctrl+c` to quit at any time.
+ */
+#include <atomic>                           // atomic
+#include <cstring>                          // strcmp(), memcpy()
+#include <iostream>                         // cin, cout, endl
+#include <string>                           // string, getline()
+#include <time.h>                           // CLOCK_MONOTONIC_RAW, timespec, clock_gettime()
+#include <RF24/RF24.h>                      // RF24, RF24_PA_LOW, delay()
+#include <RF24/utility/common/tx_queue.h>   // RF24TxQueue
+#include <RF24/utility/common/rx_service.h> // RF24RxService, rf24_rx_packet_t
+
+using namespace std;
+
+/****************** Linux ***********************/
+// Radio CE Pin, CSN Pin, SPI Speed
+// CE Pin uses GPIO number with BCM and SPIDEV drivers, other platforms use their own pin numbering
+// CS Pin addresses the SPI bus number at /dev/spidev<a>.<b>
+// ie: RF24 radio(<ce_pin>, <a>*10+<b>); spidev1.0 is 10, spidev1.1 is 11 etc..
+#define CSN_PIN 0
+#ifdef MRAA
+    #define CE_PIN 15 // GPIO22
+#elif defined(RF24_WIRINGPI)
+    #define CE_PIN 3 // GPIO22
+#else
+    #define CE_PIN 22
+#endif
+// Generic:
+RF24 radio(CE_PIN, CSN_PIN);
+/****************** Linux (BBB,x86,etc) ***********************/
+// See http://nRF24.github.io/RF24/pages.html for more information on usage
+// See https://github.com/eclipse/mraa/ for more information on MRAA
+// See https://www.kernel.org/doc/Documentation/spi/spidev for more information on SPIDEV
+
+// The queue's and service's workers can sleep on the radio's IRQ pin (with the SPIDEV driver)
+// instead of polling the radio. Set this to the GPIO pin connected to the radio's IRQ pin to try it.
+#define IRQ_PIN RF24_PIN_INVALID
+
+#define SIZE 32            // the size of each payload (in bytes)
+#define COUNT 256          // the number of payloads streamed by the TX node
+#define QUEUE_DEPTH 64     // the number of payloads the software queue (and ring) can hold
+void setRole();            // prototype to set the node's role
+void master();             // prototype of the TX node's behavior
+void slave();              // prototype of the RX node's behavior
+void printHelp(string);    // prototype to function that explain CLI arg usage
+
+// custom defined timer for evaluating transmission time in microseconds
+struct timespec startTimer, endTimer;
+uint32_t getMicros(); // prototype to get elapsed time in microseconds
+
+int main(int argc, char** argv)
+{
+
+    // perform hardware check
+    if (!radio.begin()) {
+        cout << "radio hardware is not responding!!" << endl;
+        return 0; // quit now
+    }
+
+    // Let these addresses be used for the pair of nodes used in this example
+    uint8_t address[2][6] = {"1Node", "2Node"};
+    //             the TX address^ ,  ^the RX address
+
+    // to use different addresses on a pair of radios, we need a variable to
+    // uniquely identify which address this radio will use to transmit
+    bool radioNumber = 1; // 0 uses address[0] to transmit, 1 uses address[1] to transmit
+
+    bool foundArgNode = false;
+    bool foundArgRole = false;
+    bool role = false;
+    if (argc > 1) {
+        // CLI args are specified
+        if ((argc - 1) % 2 != 0) {
+            // some CLI arg doesn't have an option specified for it
+            printHelp(string(argv[0])); // all args need an option in this example
+            return 0;
+        }
+        else {
+            // iterate through args starting after program name
+            int a = 1;
+            while (a < argc) {
+                bool invalidOption = false;
+                if (strcmp(argv[a], "-n") == 0 || strcmp(argv[a], "--node") == 0) {
+                    // "-n" or "--node" has been specified
+                    foundArgNode = true;
+                    if (argv[a + 1][0] - 48 <= 1) {
+                        radioNumber = (argv[a + 1][0] - 48) == 1;
+                    }
+                    else {
+                        // option is invalid
+                        invalidOption = true;
+                    }
+                }
+                else if (strcmp(argv[a], "-r") == 0 || strcmp(argv[a], "--role") == 0) {
+                    // "-r" or "--role" has been specified
+                    foundArgRole = true;
+                    if (argv[a + 1][0] - 48 <= 1) {
+                        role = (argv[a + 1][0] - 48) == 1;
+                    }
+                    else {
+                        // option is invalid
+                        invalidOption = true;
+                    }
+                }
+                if (invalidOption) {
+                    printHelp(string(argv[0]));
+                    return 0;
+                }
+                a += 2;
+            } // while
+            if (!foundArgNode && !foundArgRole) {
+                // no valid args were specified
+                printHelp(string(argv[0]));
+                return 0;
+            }
+        } // else
+    }     // if
+
+    // print example's name
+    cout << argv[0] << endl;
+
+    if (!foundArgNode) {
+        // Set the radioNumber via the terminal on startup
+        cout << "Which radio is this? Enter '0' or '1'. Defaults to '0' ";
+        string input;
+        getline(cin, input);
+        radioNumber = input.length() > 0 && (uint8_t)input[0] == 49;
+    }
+
+    radio.setPayloadSize(SIZE); // default value is the maximum 32 bytes
+
+    // Set the PA Level low to try preventing power supply related problems
+    // because these examples are likely run with nodes in close proximity to
+    // each other.
+    radio.setPALevel(RF24_PA_LOW); // RF24_PA_MAX is default.
+
+    // set the TX address of the RX node for use on the TX pipe (pipe 0)
+    radio.stopListening(address[radioNumber]);
+
+    // set the RX address of the TX node into a RX pipe
+    radio.openReadingPipe(1, address[!radioNumber]); // using pipe 1
+
+    // ready to execute program now
+    if (!foundArgRole) { // if CLI arg "-r"/"--role" was not specified
+        setRole();       // calls master() or slave() based on user input
+    }
+    else {                         // if CLI arg "-r"/"--role" was specified
+        role ? master() : slave(); // based on CLI arg option
+    }
+    return 0;
+}
+
+/**
+ * set this node's role from stdin stream.
+ * this only considers the first char as input.
+ */
+void setRole()
+{
+    string input = "";
+    while (!input.length()) {
+        cout << "*** PRESS 'T' to begin transmitting to the other node\n";
+        cout << "*** PRESS 'R' to begin receiving from the other node\n";
+        cout << "*** PRESS 'Q' to exit" << endl;
+        getline(cin, input);
+        if (input.length() >= 1) {
+            if (input[0] == 'T' || input[0] == 't')
+                master();
+            else if (input[0] == 'R' || input[0] == 'r')
+                slave();
+            else if (input[0] == 'Q' || input[0] == 'q')
+                break;
+            else
+                cout << input[0] << " is an invalid input. Please try again." << endl;
+        }
+        input = ""; // stay in the while loop
+    }               // while
+} // setRole()
+
+/**
+ * make this node act as the transmitter
+ */
+void master()
+{
+    radio.stopListening(); // put radio in TX mode
+
+    RF24TxQueue queue(radio, QUEUE_DEPTH, IRQ_PIN);
+    queue.setResendLimit(2); // re-send a failed payload twice before dropping it
+    queue.begin();           // the radio belongs to the queue's worker until end()
+
+    atomic<unsigned int> delivered(0); // the callbacks are invoked from the worker thread
+    uint8_t payload[SIZE] = {0};
+    clock_gettime(CLOCK_MONOTONIC_RAW, &startTimer); // start the timer
+    for (unsigned int i = 0; i < COUNT; ++i) {
+        memcpy(payload, &i, sizeof(i)); // let the payload's first bytes be its sequence number
+        while (!queue.enqueue(payload, SIZE, [&delivered](bool ok) { delivered += ok; })) {
+            delay(1); // the queue is full; let the worker catch up
+        }
+    }
+    queue.end(5000);                    // wait for the queued payloads; the radio belongs to this thread again
+    uint32_t elapsedTime = getMicros(); // end the timer
+
+    cout << "Time to transmit data = " << elapsedTime << " us. ";
+    cout << COUNT - delivered << " payloads failed. Leaving TX role." << endl;
+} // master
+
+/**
+ * make this node act as the receiver
+ */
+void slave()
+{
+    RF24RxService service(radio, QUEUE_DEPTH, IRQ_PIN);
+    service.begin(); // put radio in RX mode; the radio belongs to the service's worker until end()
+
+    unsigned int counter = 0;
+    unsigned int gaps = 0;     // the number of times a payload's sequence number was unexpected
+    unsigned int expected = 0; // the next sequence number
+    rf24_rx_packet_t packet;
+    while (service.wait(packet, 6000)) { // use 6 second timeout
+        unsigned int sequence;
+        memcpy(&sequence, packet.data, sizeof(sequence));
+        gaps += sequence != expected;
+        expected = sequence + 1;
+        counter++;
+    }
+    service.end();
+    radio.stopListening(); // use TX mode for idle behavior
+
+    cout << "Received " << counter << " payloads (" << gaps << " out of sequence, ";
+    cout << service.dropped() << " dropped by a full ring). ";
+    cout << "Nothing received in 6 seconds. Leaving RX role." << endl;
+}
+
+/**
+ * Calculate the elapsed time in microseconds
+ */
+uint32_t getMicros()
+{
+    // this function assumes that the timer was started using
+    // `clock_gettime(CLOCK_MONOTONIC_RAW, &startTimer);`
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &endTimer);
+    uint32_t seconds = endTimer.tv_sec - startTimer.tv_sec;
+    uint32_t useconds = (endTimer.tv_nsec - startTimer.tv_nsec) / 1000;
+
+    return ((seconds)*1000000 + useconds) + 0.5;
+}
+
+/**
+ * print a manual page of instructions on how to use this example's CLI args
+ */
+void printHelp(string progName)
+{
+    cout << "usage: " << progName << " [-h] [-n {0,1}] [-r {0,1}]\n\n"
+         << "An example of streaming data through a software TX queue and RX ring.\n"
+         << "\nThis example was written to be used on 2 devices acting as 'nodes'.\n"
+         << "\noptional arguments:\n  -h, --help\t\tshow this help message and exit\n"
+         << "  -n {0,1}, --node {0,1}\n\t\t\tthe identifying radio number\n"
+         << "  -r {0,1}, --role {0,1}\n\t\t\t'1' specifies the TX role."
+         << " '0' specifies the RX role." << endl;
+}
@@ -43,10 +43,19 @@
  * - 2 signals detected on channel 19
  *
  * Each line of signal counts represent 100 passes of the supported spectrum.
+ *
+ * Recording mode:
+ *   scanner <log file> [<size in MiB>]
+ * records the full signal counts of every 100 passes (with a timestamp) in a ring file
+ * instead (see spectrum_log.h). The oldest records are overwritten once the file is full
+ * (16 MiB by default). Use the spectrum_csv example to export the recorded data.
  */
+#include <stdlib.h> // strtoul()
+#include <time.h>   // clock_gettime()
 #include <string>   // string, getline()
 #include <iostream> // cout, endl, flush, cin
 #include <RF24/RF24.h>
+#include "spectrum_log.h"
 
 using namespace std;
 
@@ -72,7 +81,7 @@ RF24 radio(CE_PIN, CSN_PIN);
 
 // Channel info
 const uint8_t num_channels = 126; // 0-125 are supported
-uint8_t values[num_channels];     // the array to store summary of signal counts per channel
+uint16_t values[num_channels];    // the array to store summary of signal counts per channel
 
 // To detect noise, we'll use the worst addresses possible (a reverse engineering tactic).
 // These addresses are designed to confuse the radio into thinking
@@ -82,6 +91,7 @@ const uint8_t noiseAddress[][6] = {{0x55, 0x55}, {0xAA, 0xAA}, {0x0A, 0xAA}, {0x
 const int num_reps = 100; // number of passes for each scan of the entire spectrum
 
 void printHeader(); // prototype function for printing the channels' header
+int record(const char* path, uint64_t capacity); // prototype function for the recording mode
 
 int main(int argc, char** argv)
 {
@@ -127,11 +137,15 @@ int main(int argc, char** argv)
         radio.openReadingPipe(i, noiseAddress[i]);
     }
 
-    // Get into standby mode
+    // Stay in RX mode, so scanChannels() only has to hop between channels
     radio.startListening();
-    radio.stopListening();
-    radio.flush_rx();
     // radio.printPrettyDetails();
+
+    if (argc > 1) {
+        uint64_t mebibytes = argc > 2 ? strtoul(argv[2], NULL, 0) : 16;
+        return record(argv[1], (mebibytes ? mebibytes : 16) << 20);
+    }
+
     // print the vertical header
     printHeader();
 
@@ -144,33 +158,16 @@ int main(int argc, char** argv)
         int rep_counter = num_reps;
         while (rep_counter--) {
 
-            for (int i = 0; i < num_channels; ++i) {
+            // Sweep all channels once (listening 170 microseconds on each)
+            radio.scanChannels(0, num_channels - 1, 170, 1, values);
 
-                // Select this channel
-                radio.setChannel(i);
-
-                // Listen for a little
-                radio.startListening();
-                delayMicroseconds(130);
-                bool foundSignal = radio.testRPD();
-                radio.stopListening();
-
-                // Did we get a signal?
-                if (foundSignal || radio.testRPD() || radio.available()) {
-                    ++values[i];
-                    radio.flush_rx(); // discard packets of noise
-                }
-
-                // output the summary/snapshot for this channel
-                if (values[i]) {
-                    // Print out channel measurements, clamped to a single hex digit
-                    cout << hex << min(0xF, static_cast<int>(values[i])) << flush;
-                }
-                else {
-                    cout << '-' << flush;
-                }
+            // output the summary/snapshot (1 write per sweep)
+            string line(num_channels + 1, '\r');
+            for (int i = 0; i < num_channels; ++i) {
+                // Print out channel measurements, clamped to a single hex digit
+                line[i] = values[i] ? "0123456789abcdef"[min(0xF, static_cast<int>(values[i]))] : '-';
             }
-            cout << '\r' << flush;
+            cout << line << flush;
         }
         cout << endl;
     }
@@ -178,6 +175,33 @@ int main(int argc, char** argv)
     return 0;
 }
 
+int record(const char* path, uint64_t capacity)
+{
+    SpectrumLog log;
+    if (!log.create(path, 0, num_channels - 1, capacity)) {
+        cout << "Can't open " << path << "; " << strerror(errno) << endl;
+        return 1;
+    }
+    cout << "Recording to " << path << " (" << (log.info()->capacity >> 20) << " MiB). Press Ctrl+C to stop." << endl;
+
+    SpectrumRecord scan;
+    scan.dataRate = radio.getDataRate();
+    scan.sweeps = num_reps;
+    scan.dwell = 170;
+    uint64_t count = 0;
+    while (1) {
+        memset(scan.hits, 0, sizeof(scan.hits));
+        radio.scanChannels(0, num_channels - 1, scan.dwell, scan.sweeps, scan.hits);
+
+        timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        scan.time = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+        log.append(scan);
+        cout << '\r' << ++count << " records" << flush;
+    }
+    return 0;
+}
+
 void printHeader()
 {
     // print the hundreds digits
@@ -0,0 +1,60 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * Export a spectrum log recorded by the scanner example to CSV.
+ *
+ * Each row is a record: the time (in seconds since the Unix epoch), the number of sweeps
+ * counted, the time spent on each channel per sweep (in microseconds), the data rate (in
+ * kbps) and the hit count of every recorded channel.
+ *
+ * Usage: spectrum_csv <log file> > spectrum.csv
+ */
+#include <stdio.h>  // printf(), fprintf(), setvbuf()
+#include <string.h> // strerror()
+#include "spectrum_log.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <log file>\n", argv[0]);
+        return 1;
+    }
+
+    SpectrumLog log;
+    if (!log.open(argv[1])) {
+        fprintf(stderr, "Can't open %s; %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+    const SpectrumLogHeader* info = log.info();
+
+    static char buffer[1 << 16];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer)); // stdout is only flushed when the buffer is full
+
+    printf("time,sweeps,dwell_us,data_rate_kbps");
+    for (int channel = info->first; channel <= info->last; ++channel) {
+        printf(",ch%d", channel);
+    }
+    printf("\n");
+
+    // the values of rf24_datarate_e
+    const unsigned kbps[] = {1000, 2000, 250};
+    int channels = info->last - info->first + 1;
+    uint64_t records = log.forEach([&](const SpectrumRecord& record) {
+        printf("%llu.%09llu,%u,%u,%u",
+               static_cast<unsigned long long>(record.time / 1000000000ULL),
+               static_cast<unsigned long long>(record.time % 1000000000ULL),
+               record.sweeps, record.dwell, record.dataRate < 3 ? kbps[record.dataRate] : 0);
+        for (int i = 0; i < channels; ++i) {
+            printf(",%u", record.hits[i]);
+        }
+        printf("\n");
+    });
+
+    fflush(stdout);
+    fprintf(stderr, "%llu records exported (%llu appended in total)\n",
+            static_cast<unsigned long long>(records), static_cast<unsigned long long>(info->records));
+    return 0;
+}
@@ -0,0 +1,354 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * @file spectrum_log.h
+ * A memory-mapped ring file of channel scans (written by scanner.cpp, read by spectrum_csv.cpp).
+ *
+ * The file starts with a SpectrumLogHeader followed by a ring of `capacity` bytes.
+ * Records are appended at `head` and the oldest records are dropped from `tail` to make
+ * room. Both are byte counts that only grow; their offset into the ring is the count
+ * modulo `capacity`, so a record may wrap around the end of the file.
+ *
+ * A record is a 16 byte header (little-endian, see SpectrumLog::append()) followed by
+ * the hit count of each channel as the difference from the previous record (or from 0 in
+ * a key record). The differences are varints: an even value `2n` skips `n` unchanged
+ * channels, an odd value `2z + 1` is a changed channel whose zigzag-encoded difference is
+ * `z`. Unchanged channels at the end of a record are omitted.
+ */
+#ifndef RF24_EXAMPLES_LINUX_SPECTRUM_LOG_H_
+#define RF24_EXAMPLES_LINUX_SPECTRUM_LOG_H_
+
+#include <errno.h>    // errno
+#include <fcntl.h>    // open()
+#include <stdint.h>   // uintXX_t
+#include <string.h>   // memcmp(), memcpy(), memset()
+#include <sys/mman.h> // mmap(), msync(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h>   // close(), ftruncate()
+
+#define SPECTRUM_LOG_MAGIC        "RF24SPEC"
+#define SPECTRUM_LOG_VERSION      1
+#define SPECTRUM_LOG_KEY_INTERVAL 64  // a key record is written every 64 records
+#define SPECTRUM_RECORD_KEY       0x01 // the record's counts do not depend on the previous record
+#define SPECTRUM_RECORD_HEADER    16
+#define SPECTRUM_MAX_CHANNELS     126
+#define SPECTRUM_MAX_RECORD       (SPECTRUM_RECORD_HEADER + SPECTRUM_MAX_CHANNELS * 3)
+
+/** The start of a spectrum log file (in the host's byte order) */
+struct SpectrumLogHeader
+{
+    char magic[8];       // SPECTRUM_LOG_MAGIC (not null-terminated)
+    uint16_t version;    // SPECTRUM_LOG_VERSION
+    uint8_t first;       // the first channel of every record
+    uint8_t last;        // the last channel of every record
+    uint32_t reserved;   // 0
+    uint64_t capacity;   // the size of the ring (in bytes)
+    uint64_t head;       // the number of bytes ever appended
+    uint64_t tail;       // the position of the oldest record (also a count of bytes)
+    uint64_t records;    // the number of records ever appended
+    uint8_t padding[16]; // 0
+};
+
+static_assert(sizeof(SpectrumLogHeader) == 64, "the file layout must not depend on the compiler");
+
+/** A decoded record */
+struct SpectrumRecord
+{
+    uint64_t time;                        // nanoseconds since the Unix epoch
+    uint16_t sweeps;                      // the number of sweeps counted in `hits`
+    uint16_t dwell;                       // the time spent on each channel per sweep (in microseconds)
+    uint8_t dataRate;                     // the rf24_datarate_e used to scan
+    uint8_t flags;                        // SPECTRUM_RECORD_KEY or 0
+    uint16_t hits[SPECTRUM_MAX_CHANNELS]; // the hit counts of channels `first` to `last`
+};
+
+class SpectrumLog
+{
+public:
+    SpectrumLog() : fd(-1), header(nullptr), ring(nullptr), sinceKey(SPECTRUM_LOG_KEY_INTERVAL) {}
+
+    ~SpectrumLog() { close(); }
+
+    /**
+     * Open a log for appending, creating it if needed.
+     * An existing log keeps its capacity but must have been created for the same channels.
+     * @returns false on failure (with `errno` set).
+     */
+    bool create(const char* path, uint8_t first, uint8_t last, uint64_t capacity)
+    {
+        if (first > last || last >= SPECTRUM_MAX_CHANNELS || capacity < SPECTRUM_MAX_RECORD) {
+            errno = EINVAL;
+            return false;
+        }
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0) {
+            return fail();
+        }
+        bool created = !st.st_size;
+        if (created && ftruncate(fd, static_cast<off_t>(sizeof(SpectrumLogHeader) + capacity)) < 0) {
+            return fail();
+        }
+        if (!map(PROT_READ | PROT_WRITE, created)) {
+            return false;
+        }
+        if (created) {
+            memcpy(header->magic, SPECTRUM_LOG_MAGIC, sizeof(header->magic));
+            header->version = SPECTRUM_LOG_VERSION;
+            header->first = first;
+            header->last = last;
+            header->capacity = capacity;
+        }
+        else if (header->first != first || header->last != last) {
+            errno = EINVAL;
+            return fail();
+        }
+        sinceKey = SPECTRUM_LOG_KEY_INTERVAL; // the previous counts are unknown
+        return true;
+    }
+
+    /**
+     * Open an existing log for reading.
+     * @returns false on failure (with `errno` set).
+     */
+    bool open(const char* path)
+    {
+        fd = ::open(path, O_RDONLY);
+        return fd >= 0 && map(PROT_READ, false);
+    }
+
+    /** Write the log to storage and close it */
+    void close()
+    {
+        if (header) {
+            msync(header, sizeof(SpectrumLogHeader) + header->capacity, MS_SYNC);
+            munmap(header, sizeof(SpectrumLogHeader) + header->capacity);
+            header = nullptr;
+            ring = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    /** The header of the open log (or nullptr) */
+    const SpectrumLogHeader* info() const { return header; }
+
+    /**
+     * Append a record, dropping the oldest records if the ring is full.
+     *
+     * | offset | size | field |
+     * |--------|------|-------|
+     * | 0 | 2 | size of the record (including this header) |
+     * | 2 | 1 | flags |
+     * | 3 | 1 | data rate |
+     * | 4 | 2 | sweeps |
+     * | 6 | 2 | dwell time |
+     * | 8 | 8 | time |
+     */
+    void append(const SpectrumRecord& record)
+    {
+        uint8_t buf[SPECTRUM_MAX_RECORD];
+        uint8_t channels = static_cast<uint8_t>(header->last - header->first + 1);
+        bool key = sinceKey >= SPECTRUM_LOG_KEY_INTERVAL;
+        size_t size = SPECTRUM_RECORD_HEADER;
+        uint32_t unchanged = 0;
+        for (uint8_t i = 0; i < channels; ++i) {
+            int32_t diff = record.hits[i] - (key ? 0 : previous[i]);
+            if (!diff) {
+                ++unchanged;
+                continue;
+            }
+            if (unchanged) {
+                size += put_varint(buf + size, unchanged << 1);
+                unchanged = 0;
+            }
+            uint32_t zigzag = (static_cast<uint32_t>(diff) << 1) ^ static_cast<uint32_t>(diff >> 31);
+            size += put_varint(buf + size, zigzag << 1 | 1);
+        }
+        memcpy(previous, record.hits, channels * sizeof(uint16_t));
+
+        put_le(buf, size, 2);
+        buf[2] = key ? SPECTRUM_RECORD_KEY : 0;
+        buf[3] = record.dataRate;
+        put_le(buf + 4, record.sweeps, 2);
+        put_le(buf + 6, record.dwell, 2);
+        put_le(buf + 8, record.time, 8);
+
+        // make room before overwriting the oldest records
+        uint64_t head = header->head;
+        uint64_t tail = header->tail;
+        while (head + size - tail > header->capacity) {
+            uint8_t oldest[2];
+            get(tail, oldest, 2);
+            tail += static_cast<uint64_t>(get_le(oldest, 2));
+        }
+        __atomic_store_n(&header->tail, tail, __ATOMIC_RELEASE);
+        put(head, buf, size);
+        __atomic_store_n(&header->head, head + size, __ATOMIC_RELEASE);
+        ++header->records;
+        sinceKey = key ? 1 : sinceKey + 1;
+    }
+
+    /**
+     * Decode the records from the oldest to the newest.
+     * Records before the oldest key record are skipped.
+     * @param callback Called with each `const SpectrumRecord&`.
+     * @returns The number of decoded records.
+     */
+    template <typename Callback>
+    uint64_t forEach(Callback callback) const
+    {
+        uint64_t head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+        uint64_t offset = __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE);
+        uint8_t channels = static_cast<uint8_t>(header->last - header->first + 1);
+        SpectrumRecord record;
+        memset(&record, 0, sizeof(record));
+        bool based = false;
+        uint64_t count = 0;
+        uint8_t buf[SPECTRUM_MAX_RECORD];
+        while (offset + SPECTRUM_RECORD_HEADER <= head) {
+            get(offset, buf, 2);
+            size_t size = static_cast<size_t>(get_le(buf, 2));
+            if (size < SPECTRUM_RECORD_HEADER || size > SPECTRUM_MAX_RECORD || offset + size > head) {
+                break; // corrupted (or overwritten while reading)
+            }
+            get(offset, buf, size);
+            offset += size;
+            record.flags = buf[2];
+            if (!(record.flags & SPECTRUM_RECORD_KEY) && !based) {
+                continue; // the previous counts were dropped
+            }
+            if (record.flags & SPECTRUM_RECORD_KEY) {
+                memset(record.hits, 0, sizeof(record.hits));
+                based = true;
+            }
+            record.dataRate = buf[3];
+            record.sweeps = static_cast<uint16_t>(get_le(buf + 4, 2));
+            record.dwell = static_cast<uint16_t>(get_le(buf + 6, 2));
+            record.time = get_le(buf + 8, 8);
+            size_t i = SPECTRUM_RECORD_HEADER;
+            uint32_t channel = 0;
+            while (i < size && channel < channels) {
+                uint32_t value = get_varint(buf, size, i);
+                if (value & 1) {
+                    uint32_t zigzag = value >> 1;
+                    int32_t diff = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+                    record.hits[channel] = static_cast<uint16_t>(record.hits[channel] + diff);
+                    ++channel;
+                }
+                else {
+                    channel += value >> 1;
+                }
+            }
+            callback(static_cast<const SpectrumRecord&>(record));
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    bool map(int protection, bool created)
+    {
+        struct stat st;
+        if (fstat(fd, &st) < 0) {
+            return fail();
+        }
+        if (static_cast<size_t>(st.st_size) < sizeof(SpectrumLogHeader) + SPECTRUM_MAX_RECORD) {
+            errno = EINVAL;
+            return fail();
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), protection, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            return fail();
+        }
+        SpectrumLogHeader* found = static_cast<SpectrumLogHeader*>(mapped);
+        if (!created && (memcmp(found->magic, SPECTRUM_LOG_MAGIC, sizeof(found->magic)) || found->version != SPECTRUM_LOG_VERSION
+                         || found->capacity + sizeof(SpectrumLogHeader) != static_cast<uint64_t>(st.st_size))) {
+            munmap(mapped, static_cast<size_t>(st.st_size));
+            errno = EINVAL; // not a spectrum log (or from a host with another byte order)
+            return fail();
+        }
+        header = found;
+        ring = static_cast<uint8_t*>(mapped) + sizeof(SpectrumLogHeader);
+        return true;
+    }
+
+    bool fail()
+    {
+        int error = errno;
+        close();
+        errno = error;
+        return false;
+    }
+
+    // copy to/from the ring, wrapping around its end
+    void put(uint64_t position, const uint8_t* data, size_t len)
+    {
+        for (size_t i = 0; i < len; ++i) {
+            ring[(position + i) % header->capacity] = data[i];
+        }
+    }
+
+    void get(uint64_t position, uint8_t* data, size_t len) const
+    {
+        for (size_t i = 0; i < len; ++i) {
+            data[i] = ring[(position + i) % header->capacity];
+        }
+    }
+
+    static void put_le(uint8_t* buf, uint64_t value, uint8_t len)
+    {
+        for (uint8_t i = 0; i < len; ++i) {
+            buf[i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+    }
+
+    static uint64_t get_le(const uint8_t* buf, uint8_t len)
+    {
+        uint64_t value = 0;
+        for (uint8_t i = 0; i < len; ++i) {
+            value |= static_cast<uint64_t>(buf[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    static size_t put_varint(uint8_t* buf, uint32_t value)
+    {
+        size_t len = 0;
+        while (value >= 0x80) {
+            buf[len++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        buf[len++] = static_cast<uint8_t>(value);
+        return len;
+    }
+
+    static uint32_t get_varint(const uint8_t* buf, size_t size, size_t& i)
+    {
+        uint32_t value = 0;
+        for (uint8_t shift = 0; i < size && shift < 32; shift = static_cast<uint8_t>(shift + 7)) {
+            uint8_t byte = buf[i++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    int fd;
+    SpectrumLogHeader* header;
+    uint8_t* ring;
+    uint16_t previous[SPECTRUM_MAX_CHANNELS]; // the counts of the last appended record
+    uint32_t sinceKey;                        // the number of records appended since the last key record
+};
+
+#endif // RF24_EXAMPLES_LINUX_SPECTRUM_LOG_H_
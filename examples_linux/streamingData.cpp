@@ -12,7 +12,7 @@
  */
 #include <cmath>       // abs()
 #include <ctime>       // time()
-#include <cstring>     // strcmp()
+#include <cstring>     // strcmp(), memcpy()
 #include <iostream>    // cin, cout, endl
 #include <string>      // string, getline()
 #include <time.h>      // CLOCK_MONOTONIC_RAW, timespec, clock_gettime()
@@ -202,40 +202,32 @@ void master()
 {
     radio.stopListening(); // put radio in TX mode
 
-    unsigned int failures = 0; // keep track of failures
-    uint8_t i = 0;
-    clock_gettime(CLOCK_MONOTONIC_RAW, &startTimer); // start the timer
-    while (i < SIZE) {
+    // construct every payload before streaming them all at once
+    char payloads[SIZE][SIZE];
+    const void* bufs[SIZE];
+    uint8_t lens[SIZE];
+    for (uint8_t i = 0; i < SIZE; ++i) {
         makePayload(i);
-        if (!radio.writeFast(&buffer, SIZE)) {
-            uint8_t flags = radio.getStatusFlags();
-            if (flags & RF24_TX_DF) {
-                failures++;
-                // failed to transmit a previous payload.
-                // Now we need to reset the tx_df flag and the CE pin
-                radio.ce(LOW);
-                radio.clearStatusFlags(RF24_TX_DF);
-                radio.ce(HIGH);
-            }
-            // else the TX FIFO is full; just continue loop
-        }
-        else {
-            i++;
-        }
+        memcpy(payloads[i], buffer, SIZE);
+        bufs[i] = payloads[i];
+        lens[i] = SIZE;
+    }
 
-        if (failures >= 100) {
-            // most likely no device is listening for the data stream
-            cout << "Too many failures detected. ";
-            cout << "Aborting at payload " << buffer[0];
-            break;
-        }
-    } // while
+    uint32_t acked = 0; // a bit for each delivered payload (SIZE is at most 32)
+    clock_gettime(CLOCK_MONOTONIC_RAW, &startTimer); // start the timer
+    // payloads that failed to transmit are retried a few times before they are skipped
+    size_t delivered = radio.writeMany(bufs, lens, SIZE, false, &acked, RF24_TX_RETRY);
 
     uint32_t elapsedTime = getMicros(); // end the timer
     cout << "Time to transmit data = ";
-    cout << elapsedTime;         // print the timer result
-    cout << " us. " << failures; // print number of retries
-    cout << " failures detected. Leaving TX role." << endl;
+    cout << elapsedTime; // print the timer result
+    cout << " us. " << SIZE - delivered; // print number of lost payloads
+    cout << " payloads failed. Leaving TX role." << endl;
+    for (uint8_t i = 0; i < SIZE; ++i) {
+        if (!(acked & (1UL << i))) {
+            cout << "Payload " << payloads[i][0] << " was not delivered" << endl;
+        }
+    }
 } // master
 
 /**
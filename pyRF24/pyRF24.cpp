@@ -146,6 +146,13 @@ bp::object sprintfPrettyDetails_wrap(RF24& ref)
     return ret_str;
 }
 
+bp::object sprintfDetails_wrap(RF24& ref, rf24_details_format_e format)
+{
+    char buf[1024];
+    ref.sprintfDetails(buf, sizeof(buf), format);
+    return bp::object(bp::handle<>(PyUnicode_FromString(buf)));
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(txStandBy_wrap1, RF24::txStandBy, 0, 2)
 //BOOST_PYTHON_FUNCTION_OVERLOADS(txStandBy_wrap2, RF24::txStandBy, 1, 2)
 
@@ -285,6 +292,11 @@ BOOST_PYTHON_MODULE(RF24)
         .value("RF24_PA_ERROR", RF24_PA_ERROR)
         .export_values();
 
+    bp::enum_<rf24_details_format_e>("rf24_details_format_e")
+        .value("RF24_DETAILS_KEY_VALUE", RF24_DETAILS_KEY_VALUE)
+        .value("RF24_DETAILS_JSON", RF24_DETAILS_JSON)
+        .export_values();
+
     bp::enum_<rf24_fifo_state_e>("rf24_fifo_state_e")
         .value("RF24_FIFO_OCCUPIED", RF24_FIFO_OCCUPIED)
         .value("RF24_FIFO_EMPTY", RF24_FIFO_EMPTY)
@@ -339,6 +351,7 @@ BOOST_PYTHON_MODULE(RF24)
         .def("printStatus", &RF24::printStatus)
         .def("printPrettyDetails", &RF24::printPrettyDetails)
         .def("sprintfPrettyDetails", &sprintfPrettyDetails_wrap)
+        .def("sprintfDetails", &sprintfDetails_wrap, (bp::arg("format") = RF24_DETAILS_JSON))
         .def("reUseTX", &RF24::reUseTX)
         .def("read", &read_wrap, (bp::arg("maxlen")))
         .def("rxFifoFull", &RF24::rxFifoFull)
@@ -358,6 +371,7 @@ BOOST_PYTHON_MODULE(RF24)
         .def("startWrite", &startWrite_wrap, (bp::arg("buf"), bp::arg("len"), bp::arg("multicast")))
         .def("stopListening", (void(::RF24::*)(void))(&RF24::stopListening))
         .def("stopListening", &stopListening_wrap, (bp::arg("txAddress")))
+        .def("setFastTurnaround", &RF24::setFastTurnaround, (bp::arg("enable")))
         .def("testCarrier", &RF24::testCarrier)
         .def("testRPD", &RF24::testRPD)
         .def("toggleAllPipes", &RF24::toggleAllPipes)
@@ -0,0 +1,146 @@
+/*
+ * See documentation at https://nRF24.github.io/RF24
+ * See License information at root directory of this library
+ */
+
+/**
+ * Measure the SPI traffic caused by the public RF24 API.
+ *
+ * Every benchmarked function is called a number of times. The transactions, bytes and
+ * syscalls counted by the CountingSPI shim (see spi_counter.h) are reported as JSON on
+ * stdout, along with the wall time spent in the function.
+ *
+ * Usage: rf24_bench [-c <ce_pin>] [-s <csn_pin>] [-n <iterations>]
+ */
+#include <fcntl.h>  // open()
+#include <stdio.h>  // printf(), fflush()
+#include <stdlib.h> // strtoul()
+#include <string.h> // strcmp()
+#include <unistd.h> // dup(), dup2(), close()
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../RF24.h"
+
+#ifndef RF24_BENCH_DRIVER
+    #define RF24_BENCH_DRIVER "unknown"
+#endif
+
+// the default pins match the Linux examples
+#define CSN_PIN 0
+#ifdef MRAA
+    #define CE_PIN 15 // GPIO22
+#elif defined(RF24_WIRINGPI)
+    #define CE_PIN 3 // GPIO22
+#else
+    #define CE_PIN 22
+#endif
+
+struct BenchResult
+{
+    std::string api;
+    uint32_t calls;
+    uint32_t succeeded; // the number of calls that returned `true` (if the function returns a bool)
+    rf24_spi_counters_t spi;
+    uint64_t wallNanoseconds;
+};
+
+static std::vector<BenchResult> results;
+
+// call a function repeatedly and record the SPI activity it caused
+static void bench(const char* api, uint32_t iterations, const std::function<bool()>& call)
+{
+    BenchResult result = {api, iterations, 0, {0, 0, 0, 0, 0}, 0};
+    rf24_spi_counters_t before = rf24_spi_counters;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        result.succeeded += call();
+    }
+    result.wallNanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    result.spi.transactions = rf24_spi_counters.transactions - before.transactions;
+    result.spi.bytes = rf24_spi_counters.bytes - before.bytes;
+    result.spi.syscalls = rf24_spi_counters.syscalls - before.syscalls;
+    result.spi.nanoseconds = rf24_spi_counters.nanoseconds - before.nanoseconds;
+    result.spi.overheadNanoseconds = rf24_spi_counters.overheadNanoseconds - before.overheadNanoseconds;
+    results.push_back(result);
+}
+
+static void print_json(uint32_t iterations)
+{
+    printf("{\n  \"driver\": \"%s\",\n  \"iterations\": %u,\n  \"results\": [\n", RF24_BENCH_DRIVER, iterations);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        printf("    {\"api\": \"%s\", \"calls\": %u, \"succeeded\": %u, \"transactions\": %llu, \"bytes\": %llu, "
+               "\"syscalls\": %llu, \"spi_ns\": %llu, \"transaction_ns\": %llu, \"wall_ns\": %llu}%s\n",
+               r.api.c_str(), r.calls, r.succeeded,
+               static_cast<unsigned long long>(r.spi.transactions), static_cast<unsigned long long>(r.spi.bytes),
+               static_cast<unsigned long long>(r.spi.syscalls), static_cast<unsigned long long>(r.spi.nanoseconds),
+               static_cast<unsigned long long>(r.spi.overheadNanoseconds),
+               static_cast<unsigned long long>(r.wallNanoseconds), i + 1 < results.size() ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+    rf24_gpio_pin_t cePin = CE_PIN;
+    rf24_gpio_pin_t csnPin = CSN_PIN;
+    uint32_t iterations = 100;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        unsigned long value = strtoul(argv[i + 1], NULL, 0);
+        if (!strcmp(argv[i], "-c")) {
+            cePin = static_cast<rf24_gpio_pin_t>(value);
+        }
+        else if (!strcmp(argv[i], "-s")) {
+            csnPin = static_cast<rf24_gpio_pin_t>(value);
+        }
+        else if (!strcmp(argv[i], "-n")) {
+            iterations = value ? static_cast<uint32_t>(value) : 1;
+        }
+    }
+
+    try {
+        RF24 radio(cePin, csnPin);
+        uint8_t address[6] = "1Node";
+        uint8_t buffer[32] = {0};
+
+        bench("begin", 1, [&] { return radio.begin(); });
+        if (!radio.isChipConnected()) {
+            fprintf(stderr, "radio hardware is not responding!!\n");
+            return 1;
+        }
+
+        // keep the details off stdout, which only holds the JSON
+        fflush(stdout);
+        int console = dup(STDOUT_FILENO);
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+        bench("printPrettyDetails", iterations, [&] { radio.printPrettyDetails(); return true; });
+        fflush(stdout);
+        dup2(console, STDOUT_FILENO);
+        close(console);
+
+        // with nobody listening, every write() runs through all retries
+        bench("stopListening", iterations, [&] { radio.stopListening(address); return true; });
+        bench("write", iterations, [&] { return radio.write(buffer, sizeof(buffer)); });
+        radio.flush_tx();
+        bench("writeFast", iterations, [&] { return radio.writeFast(buffer, sizeof(buffer)); });
+        radio.txStandBy(1000);
+        radio.flush_tx();
+        bench("startListening", iterations, [&] { radio.startListening(); return true; });
+        bench("available", iterations, [&] { return radio.available(); });
+        bench("read", iterations, [&] { radio.read(buffer, sizeof(buffer)); return true; });
+        radio.stopListening();
+        radio.powerDown();
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    print_json(iterations);
+    return 0;
+}
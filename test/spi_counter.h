@@ -0,0 +1,128 @@
+/**
+ * @file spi_counter.h
+ * A counting (and timing) shim around the active Linux driver's SPI class.
+ *
+ * This header is force-included (`-include spi_counter.h`) when compiling RF24.cpp and
+ * rf24_bench.cpp, so the `SPI spi` member of the RF24 class becomes a CountingSPI. The
+ * driver's own sources are compiled without it.
+ */
+#ifndef RF24_TEST_SPI_COUNTER_H_
+#define RF24_TEST_SPI_COUNTER_H_
+
+#include <stdint.h>
+#include <chrono>
+#include "../RF24_config.h" // declares the driver's SPI class
+
+#if defined(RF24_RPi) || defined(RF24_VIRTUAL)
+    // these drivers access the SPI peripheral (or the emulated radio) without entering the kernel
+    #define RF24_BENCH_SPI_SYSCALLS 0
+#else
+    // these drivers submit every transfer with an ioctl()
+    #define RF24_BENCH_SPI_SYSCALLS 1
+#endif
+
+/** The SPI activity accumulated by all CountingSPI objects */
+struct rf24_spi_counters_t
+{
+    /// The number of CSN-delimited transactions
+    uint64_t transactions;
+    /// The number of bytes transferred (in each direction)
+    uint64_t bytes;
+    /// The number of syscalls used to submit the transactions
+    uint64_t syscalls;
+    /// The time spent in the driver's transfer functions (in nanoseconds)
+    uint64_t nanoseconds;
+    /// The time spent preparing and concluding transactions (in nanoseconds)
+    uint64_t overheadNanoseconds;
+};
+
+inline rf24_spi_counters_t rf24_spi_counters = {0, 0, 0, 0, 0};
+
+/** The driver's SPI class with its transfer functions counted and timed */
+class CountingSPI : public SPI
+{
+    typedef std::chrono::steady_clock clock;
+
+    static void count(uint64_t transactions, uint64_t bytes, clock::time_point start)
+    {
+        rf24_spi_counters.transactions += transactions;
+        rf24_spi_counters.bytes += bytes;
+        rf24_spi_counters.syscalls += RF24_BENCH_SPI_SYSCALLS;
+        rf24_spi_counters.nanoseconds += elapsed(start);
+    }
+
+    static uint64_t elapsed(clock::time_point start)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    }
+
+public:
+    uint8_t transfer(uint8_t tx)
+    {
+        clock::time_point start = clock::now();
+        uint8_t rx = SPI::transfer(tx);
+        count(1, 1, start);
+        return rx;
+    }
+
+    void transfernb(char* txBuf, char* rxBuf, uint32_t len)
+    {
+        clock::time_point start = clock::now();
+        SPI::transfernb(txBuf, rxBuf, len);
+        count(1, len, start);
+    }
+
+    void transfern(char* buf, uint32_t len)
+    {
+        clock::time_point start = clock::now();
+        SPI::transfern(buf, len);
+        count(1, len, start);
+    }
+
+#if defined(SPI_HAS_BATCH)
+    void transferBatch(char* buf, const uint8_t* lengths, uint8_t frames)
+    {
+        clock::time_point start = clock::now();
+        SPI::transferBatch(buf, lengths, frames);
+        uint32_t bytes = 0;
+        for (uint8_t i = 0; i < frames; ++i) {
+            bytes += lengths[i];
+        }
+        count(frames, bytes, start); // all frames are submitted at once
+    }
+#endif
+
+#if defined(SPI_HAS_GATHER)
+    void transferGather(const char* const* txBufs, const uint8_t* lengths, uint8_t buffers, char* rxBuf)
+    {
+        clock::time_point start = clock::now();
+        SPI::transferGather(txBufs, lengths, buffers, rxBuf);
+        uint32_t bytes = 0;
+        for (uint8_t i = 0; i < buffers; ++i) {
+            bytes += lengths[i];
+        }
+        count(1, bytes, start); // all buffers share 1 frame
+    }
+#endif
+
+#if defined(SPI_HAS_TRANSACTION)
+    static void beginTransaction(SPISettings settings)
+    {
+        clock::time_point start = clock::now();
+        SPI::beginTransaction(settings);
+        rf24_spi_counters.overheadNanoseconds += elapsed(start);
+    }
+
+    static void endTransaction()
+    {
+        clock::time_point start = clock::now();
+        SPI::endTransaction();
+        rf24_spi_counters.overheadNanoseconds += elapsed(start);
+    }
+#endif
+};
+
+// replace the type of RF24::spi
+#define SPI CountingSPI
+
+#endif // RF24_TEST_SPI_COUNTER_H_
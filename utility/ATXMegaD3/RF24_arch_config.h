@@ -69,5 +69,6 @@ typedef uint16_t rf24_gpio_pin_t;
 #define delay(millisec)          __msleep(millisec)
 #define delayMicroseconds(usec)  __usleep(usec)
 #define millis()                 __millis()
+#define micros()                 __micros()
 
 #endif // RF24_UTILITY_ATXMEGAD3_RF24_ARCH_CONFIG_H_
@@ -53,6 +53,17 @@ long __millis()
     return _millis;
 }
 
+uint32_t __micros()
+{
+    uint32_t ms;
+    uint16_t ticks;
+    do { // retry if the millisecond tick interrupted
+        ms = _millis;
+        ticks = TCE0.CNT;
+    } while (ms != _millis);
+    return ms * 1000 + ticks * 8; // a tick is 8 us (see __start_timer())
+}
+
 void update_milisec()
 {
     _millis++;
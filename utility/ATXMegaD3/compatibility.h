@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 //#include <time.h>
 //#include <sys/time.h>
 
@@ -26,6 +27,8 @@ void __start_timer();
 
 long __millis();
 
+uint32_t __micros();
+
 void update_milisec();
 
 #ifdef __cplusplus
@@ -45,6 +45,7 @@
     #define delay(millisec)         __msleep(millisec)
     #define delayMicroseconds(usec) __usleep(usec)
     #define millis()                __millis()
+    #define micros()                __micros()
 #endif
 
 #define INPUT  mraa::DIR_IN
@@ -53,4 +53,10 @@ typedef uint8_t rf24_gpio_pin_t;
 #define OUTPUT                   BCM2835_GPIO_FSEL_OUTP
 #define INPUT                    BCM2835_GPIO_FSEL_INPT
 
+// use the delays shared by all Linux drivers instead of bcm2835_delay() & bcm2835_delayMicroseconds()
+#undef delay
+#undef delayMicroseconds
+#define delay(millisec)         rf24_delay_ms(millisec)
+#define delayMicroseconds(usec) rf24_delay_us(usec)
+
 #endif // RF24_UTILITY_RPI_RF24_ARCH_CONFIG_H_
@@ -1,17 +1,17 @@
-#include <chrono>
 #include "compatibility.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-auto start = std::chrono::steady_clock::now();
-
 uint32_t millis(void)
 {
-    auto end = std::chrono::steady_clock::now();
+    return rf24_millis();
+}
 
-    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+uint32_t micros(void)
+{
+    return rf24_micros();
 }
 
 #ifdef __cplusplus
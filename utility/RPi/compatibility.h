@@ -2,6 +2,7 @@
 #define RF24_UTILITY_RPI_COMPATIBLITY_H_
 
 #include <stdint.h>
+#include "../common/timing.h" // rf24_delay_us(), rf24_delay_ms()
 
 #ifdef __cplusplus
 extern "C" {
@@ -9,6 +10,8 @@ extern "C" {
 
 uint32_t millis(void);
 
+uint32_t micros(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,6 +2,12 @@
  * Interrupt implementations
  */
 #include <pthread.h>
+#include <unistd.h>    // close(), read()
+#include <fcntl.h>     // open()
+#include <sys/ioctl.h> // ioctl()
+#include <string.h>    // memset(), strcpy()
+#include <time.h>      // clock_gettime(), nanosleep()
+#include <linux/gpio.h>
 #include <map>
 #include "bcm2835.h"
 #include "interrupt.h"
@@ -11,8 +17,41 @@ extern "C" {
 #endif
 
 static pthread_mutex_t irq_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t irq_latency_budget = RF24_IRQ_LATENCY_BUDGET;
 std::map<rf24_gpio_pin_t, IrqPinCache> irqCache;
 
+static uint64_t clock_ns(clockid_t clock)
+{
+    timespec now;
+    clock_gettime(clock, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static void record_event(IrqPinCache* pinCache, uint64_t latency)
+{
+    pthread_mutex_lock(&irq_mutex);
+    pinCache->stats.events++;
+    pinCache->stats.latencyTotal += latency;
+    if (latency > pinCache->stats.latencyMax) {
+        pinCache->stats.latencyMax = latency;
+    }
+    pthread_mutex_unlock(&irq_mutex);
+}
+
+// release the pin from either the GPIO character device or the BCM2835 edge detection
+static void release_pin(IrqPinCache& pinCache)
+{
+    if (pinCache.fd >= 0) {
+        close(pinCache.fd);
+        pinCache.fd = -1;
+    }
+    else {
+        bcm2835_gpio_clr_aren(pinCache.pin);
+        bcm2835_gpio_clr_afen(pinCache.pin);
+        bcm2835_gpio_set_eds(pinCache.pin);
+    }
+}
+
 // A simple struct instantiated privately to:
 // 1. properly clean up open threads
 // 2. clear BCM2835 lib's Edge Detection Status settings
@@ -23,24 +62,100 @@ struct IrqCacheDestructor
         for (std::map<rf24_gpio_pin_t, IrqPinCache>::iterator i = irqCache.begin(); i != irqCache.end(); ++i) {
             pthread_cancel(i->second.id);
             pthread_join(i->second.id, NULL);
-            bcm2835_gpio_clr_aren(i->second.pin);
-            bcm2835_gpio_clr_afen(i->second.pin);
-            bcm2835_gpio_set_eds(i->second.pin);
+            release_pin(i->second);
         }
         irqCache.clear();
     }
 } irqCacheMgr;
 
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+/**
+ * Request the pin from the GPIO character device, so the thread can sleep on its events.
+ * @returns The line request's file descriptor or -1 if the character device is unusable.
+ */
+static int request_line(rf24_gpio_pin_t pin, uint8_t mode)
+{
+    int chip = open(RF24_LINUX_GPIO_CHIP, O_RDONLY);
+    if (chip < 0) {
+        return -1;
+    }
+
+    gpio_v2_line_request request;
+    memset(&request, 0, sizeof(request));
+    strcpy(request.consumer, "RF24 IRQ");
+    request.num_lines = 1U;
+    request.offsets[0] = pin;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT; // timestamps use CLOCK_MONOTONIC
+    switch (mode) {
+        case INT_EDGE_BOTH:
+            request.config.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+        case INT_EDGE_RISING:
+            request.config.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+            break;
+        case INT_EDGE_FALLING:
+            request.config.flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+        default:
+            close(chip);
+            return -1;
+    }
+
+    int ret = ioctl(chip, GPIO_V2_GET_LINE_IOCTL, &request);
+    close(chip);
+    if (ret < 0 || request.fd <= 0) {
+        return -1;
+    }
+    return request.fd;
+}
+
+// sleep on the kernel's line events
+static void* wait_irq(void* arg)
+{
+    IrqPinCache* pinCache = (IrqPinCache*)(arg);
+    gpio_v2_line_event irqEventInfo;
+    memset(&irqEventInfo, 0, sizeof(irqEventInfo));
+
+    for (;;) {
+        int ret = read(pinCache->fd, &irqEventInfo, sizeof(gpio_v2_line_event));
+        if (ret == sizeof(gpio_v2_line_event)) {
+            record_event(pinCache, clock_ns(CLOCK_MONOTONIC) - irqEventInfo.timestamp_ns);
+            pinCache->function();
+        }
+        pthread_testcancel();
+    }
+    return NULL;
+}
+#endif // defined(GPIO_V2_GET_LINE_IOCTL)
+
+// poll the BCM2835 Event Detect Status register, sleeping when there are no events
 void* poll_irq(void* arg)
 {
     IrqPinCache* pinCache = (IrqPinCache*)(arg);
+    uint64_t lastCheck = clock_ns(CLOCK_MONOTONIC);
+    uint64_t lastEvent = lastCheck;
+    uint32_t sleepTime = 0; // in microseconds
 
     for (;;) {
         int ret = bcm2835_gpio_eds(pinCache->pin);
+        uint64_t now = clock_ns(CLOCK_MONOTONIC);
         if (ret > 0) {
             bcm2835_gpio_set_eds(pinCache->pin);
+            record_event(pinCache, now - lastCheck);
             pinCache->function();
+            lastEvent = now;
+            sleepTime = 0;
+        }
+        else if (now - lastEvent > irq_latency_budget * 100ULL) {
+            // events tend to come in bursts; only back off after spinning for 10% of the budget
+            sleepTime = sleepTime ? sleepTime * 2 : 1;
+            if (sleepTime > irq_latency_budget) {
+                sleepTime = irq_latency_budget;
+            }
+            timespec ts = {static_cast<time_t>(sleepTime / 1000000), static_cast<long>(sleepTime % 1000000) * 1000L};
+            nanosleep(&ts, NULL);
         }
+        lastCheck = now;
         pthread_testcancel();
     }
     return NULL;
@@ -51,27 +166,41 @@ int attachInterrupt(rf24_gpio_pin_t pin, uint8_t mode, void (*function)(void))
     // ensure pin is not already being used in a separate thread
     detachInterrupt(pin);
 
-    // configure the specified pin
+    // only accept the modes that both the GPIO character device and the BCM2835 fallback support
     switch (mode) {
-        case INT_EDGE_BOTH:
-            bcm2835_gpio_aren(pin);
-            bcm2835_gpio_afen(pin);
-            break;
-        case INT_EDGE_RISING:
-            bcm2835_gpio_aren(pin);
-            break;
         case INT_EDGE_FALLING:
-            bcm2835_gpio_afen(pin);
+        case INT_EDGE_RISING:
+        case INT_EDGE_BOTH:
             break;
         default:
-            // bad user input!
-            return 0; // stop here
+            return 0; // bad user input!
     }
 
     // cache details
     IrqPinCache irqPinCache;
     irqPinCache.pin = pin;
     irqPinCache.function = function;
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+    irqPinCache.fd = request_line(pin, mode);
+#endif
+    irqPinCache.stats.eventDriven = irqPinCache.fd >= 0;
+
+    if (irqPinCache.fd < 0) {
+        // fall back to the BCM2835 edge detection
+        switch (mode) {
+            case INT_EDGE_BOTH:
+                bcm2835_gpio_aren(pin);
+                bcm2835_gpio_afen(pin);
+                break;
+            case INT_EDGE_RISING:
+                bcm2835_gpio_aren(pin);
+                break;
+            case INT_EDGE_FALLING:
+                bcm2835_gpio_afen(pin);
+                break;
+        }
+    }
+
     std::pair<std::map<rf24_gpio_pin_t, IrqPinCache>::iterator, bool> indexPair = irqCache.insert(std::pair<rf24_gpio_pin_t, IrqPinCache>(pin, irqPinCache));
 
     if (!indexPair.second) {
@@ -82,7 +211,16 @@ int attachInterrupt(rf24_gpio_pin_t pin, uint8_t mode, void (*function)(void))
 
     // create and start thread
     pthread_mutex_lock(&irq_mutex);
-    pthread_create(&indexPair.first->second.id, nullptr, poll_irq, &indexPair.first->second);
+    indexPair.first->second.started = clock_ns(CLOCK_MONOTONIC);
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+    if (irqPinCache.stats.eventDriven) {
+        pthread_create(&indexPair.first->second.id, nullptr, wait_irq, &indexPair.first->second);
+    }
+    else
+#endif
+    {
+        pthread_create(&indexPair.first->second.id, nullptr, poll_irq, &indexPair.first->second);
+    }
     pthread_mutex_unlock(&irq_mutex);
 
     return 1;
@@ -96,13 +234,34 @@ int detachInterrupt(rf24_gpio_pin_t pin)
     }
     pthread_cancel(cachedPin->second.id);     // send cancel request
     pthread_join(cachedPin->second.id, NULL); // wait till thread terminates
-    bcm2835_gpio_clr_aren(cachedPin->second.pin);
-    bcm2835_gpio_clr_afen(cachedPin->second.pin);
-    bcm2835_gpio_set_eds(cachedPin->second.pin);
+    release_pin(cachedPin->second);
     irqCache.erase(cachedPin);
     return 1;
 }
 
+void setInterruptLatency(uint32_t microseconds)
+{
+    irq_latency_budget = microseconds ? microseconds : 1;
+}
+
+int getInterruptStats(rf24_gpio_pin_t pin, IrqPinStats* stats)
+{
+    std::map<rf24_gpio_pin_t, IrqPinCache>::iterator cachedPin = irqCache.find(pin);
+    if (cachedPin == irqCache.end()) {
+        return 0; // pin not in cache; just exit
+    }
+    pthread_mutex_lock(&irq_mutex);
+    *stats = cachedPin->second.stats;
+    pthread_mutex_unlock(&irq_mutex);
+
+    clockid_t cpuClock;
+    if (pthread_getcpuclockid(cachedPin->second.id, &cpuClock) == 0) {
+        stats->cpuTime = clock_ns(cpuClock);
+    }
+    stats->wallTime = clock_ns(CLOCK_MONOTONIC) - cachedPin->second.started;
+    return 1;
+}
+
 void rfNoInterrupts()
 {
 }
@@ -8,6 +8,18 @@
 #include <stdexcept>          // std::exception, std::string
 #include "RF24_arch_config.h" // rf24_gpio_pin_t
 
+#ifndef RF24_IRQ_LATENCY_BUDGET
+    /**
+     * The default maximum time (in microseconds) between checks of the Event Detect Status
+     * register. This only applies when the GPIO character device (@ref RF24_LINUX_GPIO_CHIP)
+     * cannot be used to wait for events. See setInterruptLatency().
+     */
+    #define RF24_IRQ_LATENCY_BUDGET 1000
+#endif
+
+// getInterruptStats() is available
+#define IRQ_HAS_STATS
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,12 +41,45 @@ public:
     }
 };
 
+/** Performance figures about a certain pin's ISR thread. */
+struct IrqPinStats
+{
+    /// The number of events handled.
+    uint32_t events = 0;
+
+    /// The sum of the wake-up latencies (in nanoseconds) of all handled events.
+    uint64_t latencyTotal = 0;
+
+    /// The worst wake-up latency (in nanoseconds) of all handled events.
+    uint64_t latencyMax = 0;
+
+    /// The CPU time (in nanoseconds) used by the thread, including the ISR function.
+    uint64_t cpuTime = 0;
+
+    /// The time (in nanoseconds) since the thread was started.
+    uint64_t wallTime = 0;
+
+    /// True if the thread sleeps on the kernel's GPIO line events.
+    /// False if the thread polls the BCM2835 Event Detect Status register.
+    /// When polling, latencies are measured from the previous check of the register.
+    bool eventDriven = false;
+};
+
 /** Details related to a certain pin's ISR. */
 struct IrqPinCache
 {
     /// The pin number
     rf24_gpio_pin_t pin = 0;
 
+    /// The pin request's file descriptor (or -1 if polling the Event Detect Status register)
+    int fd = -1;
+
+    /// The time (CLOCK_MONOTONIC in nanoseconds) that the thread was started
+    uint64_t started = 0;
+
+    /// Statistics about the thread (see getInterruptStats())
+    IrqPinStats stats;
+
     /// The posix thread ID.
     pthread_t id = 0;
 
@@ -53,6 +98,27 @@ int attachInterrupt(rf24_gpio_pin_t pin, uint8_t mode, void (*function)(void));
  */
 int detachInterrupt(rf24_gpio_pin_t pin);
 
+/**
+ * Set the maximum time between checks of the BCM2835 Event Detect Status register.
+ *
+ * Threads wait on the kernel's GPIO line events if @ref RF24_LINUX_GPIO_CHIP can be used.
+ * Otherwise, the Event Detect Status register is polled: briefly spinning after each event,
+ * then sleeping in increasing steps that never exceed this budget. A smaller budget lowers
+ * the wake-up latency at the cost of CPU usage.
+ *
+ * @param microseconds The latency budget. Defaults to @ref RF24_IRQ_LATENCY_BUDGET.
+ */
+void setInterruptLatency(uint32_t microseconds);
+
+/**
+ * Get the performance figures of the thread handling a pin's events.
+ *
+ * @param pin The pin previously passed to attachInterrupt().
+ * @param stats The object to store the figures in.
+ * @returns 1 if the pin has an ISR attached, 0 otherwise.
+ */
+int getInterruptStats(rf24_gpio_pin_t pin, IrqPinStats* stats);
+
 /** Deprecated, no longer functional */
 void rfNoInterrupts();
 
@@ -6,30 +6,49 @@
 static pthread_mutex_t spiMutex = PTHREAD_MUTEX_INITIALIZER;
 bool bcmIsInitialized = false;
 
+// the settings applied to the bus by the last beginTransaction() (guarded by spiMutex)
+static SPISettings busSettings;
+static bool busConfigured = false; // cleared whenever something else configures the bus
+
 SPI::SPI()
 {
 }
 
 void SPI::begin(int busNo, uint32_t spi_speed)
 {
+    if (geteuid() != 0) {
+        throw std::runtime_error("Process should run as root");
+    }
     if (!bcmIsInitialized) {
         if (!bcm2835_init()) {
             return;
         }
     }
     bcmIsInitialized = true;
-    bcm2835_spi_begin();
+    pthread_mutex_lock(&spiMutex);
+    bcm2835_spi_begin(); // resets the bus' configuration
+    busConfigured = false;
+    pthread_mutex_unlock(&spiMutex);
+}
+
+void SPI::end()
+{
+    pthread_mutex_lock(&spiMutex);
+    bcm2835_spi_end();
+    busConfigured = false;
+    pthread_mutex_unlock(&spiMutex);
 }
 
 void SPI::beginTransaction(SPISettings settings)
 {
-    if (geteuid() != 0) {
-        throw std::runtime_error("Process should run as root");
-    }
     pthread_mutex_lock(&spiMutex);
-    setBitOrder(settings.border);
-    setDataMode(settings.dataMode);
-    setClockDivider(settings.clock);
+    if (!busConfigured || settings != busSettings) {
+        bcm2835_spi_setBitOrder(settings.border);
+        bcm2835_spi_setDataMode(settings.dataMode);
+        bcm2835_spi_set_speed_hz(settings.clock);
+        busSettings = settings;
+        busConfigured = true;
+    }
 }
 
 void SPI::endTransaction()
@@ -40,17 +59,20 @@ void SPI::endTransaction()
 void SPI::setBitOrder(uint8_t bit_order)
 {
     bcm2835_spi_setBitOrder(bit_order);
+    busConfigured = false; // the next transaction has to restore its settings
 }
 
 void SPI::setDataMode(uint8_t data_mode)
 {
     bcm2835_spi_setDataMode(data_mode);
+    busConfigured = false;
 }
 
 void SPI::setClockDivider(uint32_t spi_speed)
 {
     //bcm2835_spi_setClockDivider(spi_speed);
     bcm2835_spi_set_speed_hz(spi_speed);
+    busConfigured = false;
 }
 
 void SPI::chipSelect(int csn_pin)
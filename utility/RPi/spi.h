@@ -35,12 +35,22 @@ public:
     uint8_t border;
     uint8_t dataMode;
 
+    bool operator==(const SPISettings& other) const
+    {
+        return clock == other.clock && border == other.border && dataMode == other.dataMode;
+    }
+
+    bool operator!=(const SPISettings& other) const
+    {
+        return !(*this == other);
+    }
+
 private:
-    void init(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+    void init(uint32_t _clock, uint8_t _bitOrder, uint8_t _dataMode)
     {
-        clock = clock;
-        border = bitOrder;
-        dataMode = dataMode;
+        clock = _clock;
+        border = _bitOrder;
+        dataMode = _dataMode;
     }
 
     friend class SPIClass;
@@ -71,6 +81,12 @@ public:
 
     static void chipSelect(int csn_pin);
 
+    /**
+     * Lock the bus and apply the given settings.
+     *
+     * The bus keeps its configuration between transactions, so it is only reconfigured
+     * when the settings differ from the ones applied last.
+     */
     static void beginTransaction(SPISettings settings);
 
     static void endTransaction();
@@ -24,6 +24,29 @@
 #define _BV(x) (1 << (x))
 #define _SPI   spi
 
+#if defined(SPI_HAS_BATCH)
+    // this gets triggered as /utility/SPIDEV/spi.h defines SPI_HAS_BATCH (unless modified by end-user)
+    #define RF24_SPI_BATCH
+    // the number of bytes that can be queued for a batched SPI transaction
+    #define RF24_SPI_BATCH_SIZE 96
+#endif
+
+#if defined(IRQ_HAS_WAIT)
+    // this gets triggered as /utility/SPIDEV/interrupt.h defines IRQ_HAS_WAIT (unless modified by end-user)
+    #define RF24_IRQ_WAIT
+#endif
+
+#if defined(IRQ_HAS_CONTEXT)
+    // this gets triggered as /utility/SPIDEV/interrupt.h defines IRQ_HAS_CONTEXT (unless modified by end-user)
+    #define RF24_IRQ_CONTEXT
+    #include <pthread.h> // pthread_mutex_t (the handler runs in the interrupt dispatcher's thread)
+#endif
+
+#if defined(GPIO_HAS_HANDLE)
+    // this gets triggered as /utility/SPIDEV/gpio.h defines GPIO_HAS_HANDLE (unless modified by end-user)
+    #define RF24_CE_HANDLE
+#endif
+
 #ifdef RF24_DEBUG
     #define IF_RF24_DEBUG(x) ({ x; })
 #else
@@ -61,5 +84,6 @@ typedef uint16_t prog_uint16_t;
 #define delay(millisec)          __msleep(millisec)
 #define delayMicroseconds(usec)  __usleep(usec)
 #define millis()                 __millis()
+#define micros()                 __micros()
 
 #endif // RF24_UTILITY_SPIDEV_RF24_ARCH_CONFIG_H_
@@ -1,5 +1,4 @@
-#include <time.h>
-#include <chrono>
+#include "../common/timing.h" // rf24_delay_us(), rf24_delay_ms(), rf24_millis(), rf24_micros()
 #include "compatibility.h"
 
 #ifdef __cplusplus
@@ -12,20 +11,12 @@ long long mtime, seconds, useconds;
 
 void __msleep(int millisec)
 {
-    struct timespec req; // = {0};
-    req.tv_sec = (time_t)millisec / 1000;
-    req.tv_nsec = (millisec % 1000) * 1000000L;
-    //nanosleep(&req, (struct timespec *)NULL);
-    clock_nanosleep(CLOCK_REALTIME, 0, &req, NULL);
+    rf24_delay_ms(static_cast<uint32_t>(millisec));
 }
 
 void __usleep(int microsec)
 {
-    struct timespec req; // = {0};
-    req.tv_sec = (time_t)microsec / 1000000;
-    req.tv_nsec = (microsec % 1000000) * 1000;
-    //nanosleep(&req, (struct timespec *)NULL);
-    clock_nanosleep(CLOCK_REALTIME, 0, &req, NULL);
+    rf24_delay_us(static_cast<uint32_t>(microsec));
 }
 
 /**
@@ -38,13 +29,14 @@ void __start_timer()
 {
 }
 
-auto start = std::chrono::steady_clock::now();
-
 uint32_t __millis()
 {
-    auto end = std::chrono::steady_clock::now();
+    return rf24_millis();
+}
 
-    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+uint32_t __micros()
+{
+    return rf24_micros();
 }
 
 #ifdef __cplusplus
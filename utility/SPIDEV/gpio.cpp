@@ -13,13 +13,13 @@
 #include <string.h>    // std::string, strcpy()
 #include "gpio.h"
 
-// instantiate some global structs to setup cache
-// doing this globally ensures the data struct is zero-ed out
+// instantiate a global struct to setup cache
+// doing this globally ensures the request struct is zero-ed out
 struct gpio_v2_line_request request;
-struct gpio_v2_line_values data;
 
 // initialize static members.
 int GPIOChipCache::fd = -1;
+uint32_t GPIOChipCache::lines = 0;
 std::map<rf24_gpio_pin_t, gpio_fd> GPIOChipCache::cachedPins = std::map<rf24_gpio_pin_t, gpio_fd>();
 
 void GPIOChipCache::openDevice()
@@ -35,6 +35,19 @@ void GPIOChipCache::openDevice()
             return;
         }
     }
+    if (!lines) {
+        // get chip info (only once, the number of lines never changes)
+        gpiochip_info info;
+        memset(&info, 0, sizeof(info));
+        int ret = ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &info);
+        if (ret < 0) {
+            std::string msg = "Could not gather info about ";
+            msg += RF24_LINUX_GPIO_CHIP;
+            throw GPIOException(msg);
+            return;
+        }
+        lines = info.lines;
+    }
 }
 
 void GPIOChipCache::closeDevice()
@@ -49,7 +62,6 @@ GPIOChipCache::GPIOChipCache()
 {
     request.num_lines = 1;
     strcpy(request.consumer, "RF24 lib");
-    data.mask = 1ULL; // only change value for specified pin
 }
 
 GPIOChipCache::~GPIOChipCache()
@@ -75,25 +87,6 @@ GPIO::~GPIO()
 
 void GPIO::open(rf24_gpio_pin_t port, int DDR)
 {
-    gpioCache.openDevice();
-
-    // get chip info
-    gpiochip_info info;
-    memset(&info, 0, sizeof(info));
-    int ret = ioctl(gpioCache.fd, GPIO_GET_CHIPINFO_IOCTL, &info);
-    if (ret < 0) {
-        std::string msg = "Could not gather info about ";
-        msg += RF24_LINUX_GPIO_CHIP;
-        throw GPIOException(msg);
-        return;
-    }
-
-    if (port > info.lines) {
-        std::string msg = "pin number " + std::to_string(port) + " not available for " + RF24_LINUX_GPIO_CHIP;
-        throw GPIOException(msg);
-        return;
-    }
-
     // check if pin is already in use
     std::map<rf24_gpio_pin_t, gpio_fd>::iterator pin = gpioCache.cachedPins.find(port);
     if (pin == gpioCache.cachedPins.end()) { // pin not in use; add it to cached request
@@ -104,7 +97,15 @@ void GPIO::open(rf24_gpio_pin_t port, int DDR)
         request.fd = pin->second;
     }
 
+    int ret;
     if (request.fd <= 0) {
+        gpioCache.openDevice(); // the chip stays open for subsequent requests
+        if (port > gpioCache.lines) {
+            std::string msg = "pin number " + std::to_string(port) + " not available for " + RF24_LINUX_GPIO_CHIP;
+            throw GPIOException(msg);
+            return;
+        }
+
         ret = ioctl(gpioCache.fd, GPIO_V2_GET_LINE_IOCTL, &request);
         if (ret == -1 || request.fd <= 0) {
             std::string msg = "[GPIO::open] Can't get line handle from IOCTL; ";
@@ -113,7 +114,6 @@ void GPIO::open(rf24_gpio_pin_t port, int DDR)
             return;
         }
     }
-    gpioCache.closeDevice(); // in case other apps want to access it
 
     // set the pin and direction
     request.config.flags = DDR ? GPIO_V2_LINE_FLAG_OUTPUT : GPIO_V2_LINE_FLAG_INPUT;
@@ -148,6 +148,8 @@ int GPIO::read(rf24_gpio_pin_t port)
         return -1;
     }
 
+    gpio_v2_line_values data;
+    data.mask = 1ULL; // only get value for specified pin
     data.bits = 0ULL;
 
     int ret = ioctl(pin->second, GPIO_V2_LINE_GET_VALUES_IOCTL, &data);
@@ -168,9 +170,26 @@ void GPIO::write(rf24_gpio_pin_t port, int value)
         return;
     }
 
-    data.bits = value;
+    gpio_v2_line_values data;
+    data.mask = 1ULL; // only change value for specified pin
+    write(pin->second, data, value);
+}
+
+gpio_fd GPIO::handle(rf24_gpio_pin_t port)
+{
+    std::map<rf24_gpio_pin_t, gpio_fd>::iterator pin = gpioCache.cachedPins.find(port);
+    if (pin == gpioCache.cachedPins.end() || pin->second <= 0) {
+        throw GPIOException("[GPIO::handle] pin not initialized! Use GPIO::open() first");
+        return -1;
+    }
+    return pin->second;
+}
+
+void GPIO::write(gpio_fd line, gpio_v2_line_values& values, int value)
+{
+    values.bits = value;
 
-    int ret = ioctl(pin->second, GPIO_V2_LINE_SET_VALUES_IOCTL, &data);
+    int ret = ioctl(line, GPIO_V2_LINE_SET_VALUES_IOCTL, &values);
     if (ret == -1) {
         std::string msg = "[GPIO::write] Can't set line value from IOCTL; ";
         msg += strerror(errno);
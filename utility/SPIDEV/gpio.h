@@ -38,6 +38,10 @@ public:
 
 typedef int gpio_fd; // for readability
 
+/// Defined when GPIO::handle() can expose a pin's line request to drive it without a lookup.
+/// Comment this out to make the RF24 class use GPIO::write() for every CE toggle.
+#define GPIO_HAS_HANDLE
+
 /// A struct to manage the GPIO chip file descriptor.
 /// This struct's destructor should close any cached GPIO pin requests' file descriptors.
 struct GPIOChipCache
@@ -57,7 +61,12 @@ struct GPIOChipCache
     /// struct use the same mapping.
     static std::map<rf24_gpio_pin_t, gpio_fd> cachedPins;
 
-    /// Open the File Descriptor for the GPIO chip
+    /// @brief The number of lines exposed by the GPIO chip.
+    ///
+    /// This is queried once when the chip is first opened (0 until then).
+    static uint32_t lines;
+
+    /// Open the File Descriptor for the GPIO chip (if not already open)
     void openDevice();
 
     /// Close the File Descriptor for the GPIO chip
@@ -93,6 +102,19 @@ public:
 
     static void write(rf24_gpio_pin_t port, int value);
 
+    /**
+     * Get the line request of a pin configured with open().
+     * The returned file descriptor stays valid until the pin is closed.
+     */
+    static gpio_fd handle(rf24_gpio_pin_t port);
+
+    /**
+     * Set the output level of a line returned by handle().
+     * @param values The caller's buffer for the request (its `mask` must be set to 1).
+     * This skips the pin lookup done by write(rf24_gpio_pin_t, int).
+     */
+    static void write(gpio_fd line, gpio_v2_line_values& values, int value);
+
     virtual ~GPIO();
 
 private:
@@ -2,12 +2,17 @@
  * Interrupt implementations
  */
 #include "linux/gpio.h"
-#include <unistd.h>    // close()
-#include <fcntl.h>     // open()
-#include <sys/ioctl.h> // ioctl()
-#include <errno.h>     // errno, strerror()
-#include <string.h>    // std::string, strcpy()
+#include <unistd.h>      // close(), read(), write()
+#include <fcntl.h>       // open(), fcntl()
+#include <sys/ioctl.h>   // ioctl()
+#include <sys/epoll.h>   // epoll_create1(), epoll_ctl(), epoll_wait()
+#include <sys/eventfd.h> // eventfd()
+#include <errno.h>       // errno, strerror()
+#include <string.h>      // std::string, strcpy()
 #include <pthread.h>
+#include <poll.h> // poll()
+#include <time.h> // clock_gettime()
+#include <stdio.h> // fprintf()
 #include <map>
 #include "interrupt.h"
 #include "gpio.h" // GPIOChipCache, GPIOException
@@ -17,16 +22,26 @@ extern "C" {
 #endif
 
 static pthread_mutex_t irq_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t irq_cond = PTHREAD_COND_INITIALIZER;
 std::map<rf24_gpio_pin_t, IrqPinCache> irqCache;
 
+// the epoll data of the eventfd used to stop the dispatcher (pin numbers are 16 bits)
+#define IRQ_SHUTDOWN 0xFFFFFFFFFFFFFFFFULL
+
+static pthread_t dispatcher = 0;                       // the thread calling every attached handler
+static int epollFd = -1;                               // multiplexes the pins with an attached handler
+static int shutdownFd = -1;                            // an eventfd that tells the dispatcher to return
+static rf24_gpio_pin_t dispatching = RF24_PIN_INVALID; // the pin whose handler is being called
+
+static void stopDispatcher();
+
 struct IrqChipCache : public GPIOChipCache
 {
     IrqChipCache() : GPIOChipCache() {};
     ~IrqChipCache()
     {
+        stopDispatcher();
         for (std::map<rf24_gpio_pin_t, IrqPinCache>::iterator i = irqCache.begin(); i != irqCache.end(); ++i) {
-            pthread_cancel(i->second.id);     // send cancel request
-            pthread_join(i->second.id, NULL); // wait till thread terminates
             close(i->second.fd);
         }
         irqCache.clear();
@@ -35,51 +50,165 @@ struct IrqChipCache : public GPIOChipCache
 
 IrqChipCache irqChipCache;
 
+/**
+ * Read the queued events of a pin and call its handler once per event.
+ * @param events A buffer for the events (at least `IRQ_EVENT_BUFFER_SIZE` long).
+ */
+static void dispatchEvents(rf24_gpio_pin_t pin, gpio_v2_line_event* events)
+{
+    pthread_mutex_lock(&irq_mutex);
+    std::map<rf24_gpio_pin_t, IrqPinCache>::iterator cachedPin = irqCache.find(pin);
+    if (cachedPin == irqCache.end() || !cachedPin->second.hasHandler()) {
+        pthread_mutex_unlock(&irq_mutex); // detached since epoll_wait() returned
+        return;
+    }
+    IrqPinCache& pinCache = cachedPin->second;
+    int ret = read(pinCache.fd, events, sizeof(gpio_v2_line_event) * IRQ_EVENT_BUFFER_SIZE);
+    if (ret < 0) {
+        pthread_mutex_unlock(&irq_mutex);
+        if (errno == EAGAIN || errno == EINTR) {
+            return;
+        }
+        std::string msg = "[dispatchEvents] Could not read event info; ";
+        msg += strerror(errno);
+        throw IRQException(msg);
+        return;
+    }
+    int count = ret / static_cast<int>(sizeof(gpio_v2_line_event));
+    for (int i = 0; i < count; ++i) {
+        if (events[i].id == GPIO_V2_LINE_EVENT_FALLING_EDGE) {
+            pinCache.timestamp = events[i].timestamp_ns;
+        }
+    }
+    // wake up any waitForInterrupt() calls
+    pinCache.seqno += static_cast<unsigned int>(count);
+    IrqPinCache handler = pinCache;
+    dispatching = pin;
+    pthread_cond_broadcast(&irq_cond);
+    pthread_mutex_unlock(&irq_mutex);
+
+    for (int i = 0; i < count; ++i) {
+        if (handler.contextFunction) {
+            rf24_irq_event event;
+            event.pin = pin;
+            event.edge = events[i].id == GPIO_V2_LINE_EVENT_FALLING_EDGE ? INT_EDGE_FALLING : INT_EDGE_RISING;
+            event.seqno = events[i].line_seqno;
+            event.pending = static_cast<unsigned int>(count - 1 - i);
+            event.timestamp = events[i].timestamp_ns;
+            handler.contextFunction(handler.context, event);
+        }
+        else {
+            handler.function();
+        }
+    }
+
+    // let detachInterrupt() know the handler returned
+    pthread_mutex_lock(&irq_mutex);
+    dispatching = RF24_PIN_INVALID;
+    pthread_cond_broadcast(&irq_cond);
+    pthread_mutex_unlock(&irq_mutex);
+}
+
 void* poll_irq(void* arg)
 {
-    IrqPinCache* pinCache = (IrqPinCache*)(arg);
-    unsigned int lastEventSeqNo = 0;
-    gpio_v2_line_event irqEventInfo;
-    memset(&irqEventInfo, 0, sizeof(irqEventInfo));
+    static_cast<void>(arg); // ignore -Wunused-parameter
+    epoll_event ready[8];
+    gpio_v2_line_event events[IRQ_EVENT_BUFFER_SIZE];
 
     for (;;) {
-        int ret = read(pinCache->fd, &irqEventInfo, sizeof(gpio_v2_line_event));
-        if (ret < 0) {
-            std::string msg = "[poll_irq] Could not read event info; ";
-            msg += strerror(errno);
-            throw IRQException(msg);
-            return NULL;
+        int count = epoll_wait(epollFd, ready, sizeof(ready) / sizeof(ready[0]), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // an exception can't reach the caller from this thread (it would call std::terminate())
+            fprintf(stderr, "[poll_irq] Could not wait for events; %s\n", strerror(errno));
+            return NULL; // errno is left set; no more handlers are called
         }
-        if (ret > 0 && irqEventInfo.line_seqno != lastEventSeqNo) {
-            lastEventSeqNo = irqEventInfo.line_seqno;
-            pinCache->function();
+        for (int i = 0; i < count; ++i) {
+            if (ready[i].data.u64 == IRQ_SHUTDOWN) {
+                return NULL;
+            }
+            rf24_gpio_pin_t pin = static_cast<rf24_gpio_pin_t>(ready[i].data.u64);
+            try {
+                dispatchEvents(pin, events);
+            }
+            catch (const IRQException& error) {
+                int err = errno;
+                fprintf(stderr, "%s\n", error.what());
+                // stop watching the failing pin, so its error is only reported once
+                pthread_mutex_lock(&irq_mutex);
+                std::map<rf24_gpio_pin_t, IrqPinCache>::iterator cachedPin = irqCache.find(pin);
+                if (cachedPin != irqCache.end()) {
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, cachedPin->second.fd, nullptr);
+                }
+                pthread_mutex_unlock(&irq_mutex);
+                errno = err;
+            }
         }
-        pthread_testcancel();
     }
     return NULL;
 }
 
-int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
+/**
+ * Start the dispatcher thread (if it is not running yet).
+ * The `irq_mutex` must be locked when calling this.
+ */
+static void startDispatcher()
 {
-    // ensure pin is not already being used in a separate thread
-    detachInterrupt(pin);
-    GPIO::close(pin);
-
-    irqChipCache.openDevice();
-
-    // get chip info
-    gpiochip_info info;
-    memset(&info, 0, sizeof(info));
-    int ret = ioctl(irqChipCache.fd, GPIO_GET_CHIPINFO_IOCTL, &info);
-    if (ret < 0) {
-        std::string msg = "[attachInterrupt] Could not gather info about ";
-        msg += RF24_LINUX_GPIO_CHIP;
+    if (dispatcher) {
+        return;
+    }
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    shutdownFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = IRQ_SHUTDOWN;
+    if (epollFd < 0 || shutdownFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, shutdownFd, &event) < 0) {
+        std::string msg = "[attachInterrupt] Could not create the dispatcher's file descriptors; ";
+        msg += strerror(errno);
         throw IRQException(msg);
-        return 0;
+        return;
     }
+    if (pthread_create(&dispatcher, nullptr, poll_irq, nullptr)) {
+        dispatcher = 0;
+        throw IRQException("[attachInterrupt] Could not create the dispatcher thread");
+        return;
+    }
+}
 
-    if (pin > info.lines) {
-        std::string msg = "[attachInterrupt] pin " + std::to_string(pin) + " is not available on " + RF24_LINUX_GPIO_CHIP;
+/** Stop the dispatcher thread (if it is running) and wait for it to return. */
+static void stopDispatcher()
+{
+    if (dispatcher) {
+        uint64_t one = 1;
+        if (write(shutdownFd, &one, sizeof(one)) == sizeof(one)) {
+            pthread_join(dispatcher, NULL); // wait till thread terminates
+        }
+        dispatcher = 0;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (shutdownFd >= 0) {
+        close(shutdownFd);
+        shutdownFd = -1;
+    }
+}
+
+/**
+ * Request a pin as an input that detects edges specified by `mode`.
+ * @param caller The name of the calling function (used in exception messages).
+ * @returns The file descriptor of the pin's line request (or 0 if `mode` is invalid).
+ */
+static gpio_fd requestIrqLine(rf24_gpio_pin_t pin, int mode, const char* caller)
+{
+    irqChipCache.openDevice(); // also queries the chip's number of lines (once)
+
+    if (pin > irqChipCache.lines) {
+        std::string msg = caller;
+        msg += " pin " + std::to_string(pin) + " is not available on " + RF24_LINUX_GPIO_CHIP;
         throw IRQException(msg);
         return 0;
     }
@@ -90,7 +219,7 @@ int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
     strcpy(request.consumer, "RF24 IRQ");
     request.num_lines = 1U;
     request.offsets[0] = pin;
-    request.event_buffer_size = sizeof(gpio_v2_line_event);
+    request.event_buffer_size = IRQ_EVENT_BUFFER_SIZE;
 
     // set debounce for the pin
     // request.config.attrs[0].mask = 1LL;
@@ -99,7 +228,7 @@ int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
     // request.config.num_attrs = 1U;
 
     // set pin as input and configure edge detection
-    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT; // timestamps use CLOCK_MONOTONIC
     switch (mode) {
         case INT_EDGE_BOTH:
         case INT_EDGE_RISING:
@@ -112,64 +241,239 @@ int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
     }
 
     // write pin request's config
-    ret = ioctl(irqChipCache.fd, GPIO_V2_GET_LINE_IOCTL, &request);
+    int ret = ioctl(irqChipCache.fd, GPIO_V2_GET_LINE_IOCTL, &request);
     if (ret < 0 || request.fd <= 0) {
-        std::string msg = "[attachInterrupt] Could not get line handle from ioctl; ";
+        std::string msg = caller;
+        msg += " Could not get line handle from ioctl; ";
         msg += strerror(errno);
         throw IRQException(msg);
         return 0;
     }
-    irqChipCache.closeDevice();
 
     ret = ioctl(request.fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &request.config);
     if (ret < 0) {
-        std::string msg = "[attachInterrupt] Could not set line config; ";
+        std::string msg = caller;
+        msg += " Could not set line config; ";
         msg += strerror(errno);
         throw IRQException(msg);
         return 0;
     }
+    return request.fd;
+}
+
+/**
+ * Request a pin for detecting the edges specified by `mode` and let the dispatcher
+ * thread call the handler in `irqPinCache`.
+ */
+static int attachHandler(rf24_gpio_pin_t pin, int mode, IrqPinCache& irqPinCache)
+{
+    // ensure pin is not already being dispatched
+    detachInterrupt(pin);
+    GPIO::close(pin);
+
+    gpio_fd fd = requestIrqLine(pin, mode, "[attachInterrupt]");
+    if (!fd) {
+        return 0;
+    }
+    // the dispatcher must not block on a pin whose events were already consumed
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 
     // cache details
-    IrqPinCache irqPinCache;
-    irqPinCache.fd = request.fd;
-    irqPinCache.function = function;
+    irqPinCache.fd = fd;
 
+    pthread_mutex_lock(&irq_mutex);
     std::pair<std::map<rf24_gpio_pin_t, IrqPinCache>::iterator, bool> indexPair = irqCache.insert(std::pair<rf24_gpio_pin_t, IrqPinCache>(pin, irqPinCache));
     if (!indexPair.second) {
         // this should not be reached, but indexPair.first needs to be the inserted map element
+        pthread_mutex_unlock(&irq_mutex);
         throw IRQException("[attachInterrupt] Could not cache the IRQ pin with function pointer");
         return 0;
     }
 
-    std::pair<std::map<rf24_gpio_pin_t, gpio_fd>::iterator, bool> gpioPair = irqChipCache.cachedPins.insert(std::pair<rf24_gpio_pin_t, gpio_fd>(pin, request.fd));
+    std::pair<std::map<rf24_gpio_pin_t, gpio_fd>::iterator, bool> gpioPair = irqChipCache.cachedPins.insert(std::pair<rf24_gpio_pin_t, gpio_fd>(pin, fd));
     if (!gpioPair.second) {
         // this should not be reached, but gpioPair.first needs to be the inserted map element
+        pthread_mutex_unlock(&irq_mutex);
         throw IRQException("[attachInterrupt] Could not cache the GPIO pin's file descriptor");
         return 0;
     }
 
-    // create and start thread
-    pthread_mutex_lock(&irq_mutex);
-    pthread_create(&indexPair.first->second.id, nullptr, poll_irq, &indexPair.first->second);
+    // let the dispatcher thread multiplex the pin's events
+    try {
+        startDispatcher();
+    }
+    catch (...) {
+        pthread_mutex_unlock(&irq_mutex);
+        throw;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = pin;
+    int ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
     pthread_mutex_unlock(&irq_mutex);
+    if (ret < 0) {
+        std::string msg = "[attachInterrupt] Could not watch the line for events; ";
+        msg += strerror(errno);
+        throw IRQException(msg);
+        return 0;
+    }
 
     return 1;
 }
 
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
+{
+    IrqPinCache irqPinCache;
+    irqPinCache.function = function;
+    return attachHandler(pin, mode, irqPinCache);
+}
+
 int detachInterrupt(rf24_gpio_pin_t pin)
 {
+    pthread_mutex_lock(&irq_mutex);
     std::map<rf24_gpio_pin_t, IrqPinCache>::iterator cachedPin = irqCache.find(pin);
     if (cachedPin == irqCache.end()) {
+        pthread_mutex_unlock(&irq_mutex);
         return 0; // pin not in cache; just exit
     }
-    pthread_cancel(cachedPin->second.id);     // send cancel request
-    pthread_join(cachedPin->second.id, NULL); // wait till thread terminates
+    if (cachedPin->second.hasHandler()) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, cachedPin->second.fd, nullptr);
+        // wait for the pin's handler to return (unless it is the caller)
+        while (dispatching == pin && !pthread_equal(pthread_self(), dispatcher)) {
+            pthread_cond_wait(&irq_cond, &irq_mutex);
+        }
+    }
     irqCache.erase(cachedPin);
+    pthread_mutex_unlock(&irq_mutex);
     // reconfigure the pin for basic `digitalRead()`
     GPIO::open(pin, GPIO::DIRECTION_IN);
     return 1;
 }
 
+/**
+ * Get the cached details of a pin, requesting the pin for detecting falling edges
+ * (without a thread to handle the events) if it is not cached yet.
+ * @param caller The name of the calling function (used in exception messages).
+ */
+static IrqPinCache& cacheIrqPin(rf24_gpio_pin_t pin, const char* caller)
+{
+    // hold the lock for the whole lookup-or-insert, so concurrent callers request the pin only once
+    pthread_mutex_lock(&irq_mutex);
+    std::map<rf24_gpio_pin_t, IrqPinCache>::iterator cachedPin = irqCache.find(pin);
+    if (cachedPin == irqCache.end()) {
+        IrqPinCache irqPinCache;
+        try {
+            GPIO::close(pin);
+            irqPinCache.fd = requestIrqLine(pin, INT_EDGE_FALLING, caller);
+        }
+        catch (...) {
+            pthread_mutex_unlock(&irq_mutex);
+            throw;
+        }
+        cachedPin = irqCache.insert(std::pair<rf24_gpio_pin_t, IrqPinCache>(pin, irqPinCache)).first;
+        irqChipCache.cachedPins[pin] = irqPinCache.fd;
+    }
+    pthread_mutex_unlock(&irq_mutex);
+    return cachedPin->second;
+}
+
+/**
+ * Consume the events of a pin that has no thread to handle them.
+ * @param timeout The maximum time to wait for an event (in milliseconds).
+ * @returns 1 if any event was consumed, 0 if the timeout expired.
+ */
+static int consumeEvents(IrqPinCache& pinCache, int timeout, const char* caller)
+{
+    pollfd pfd;
+    pfd.fd = pinCache.fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ret = poll(&pfd, 1, timeout);
+    if (ret < 0) {
+        if (errno == EINTR) {
+            return 0; // interrupted by a signal; let the caller check again
+        }
+        std::string msg = caller;
+        msg += " Could not poll the line; ";
+        msg += strerror(errno);
+        throw IRQException(msg);
+        return 0;
+    }
+    if (ret > 0) {
+        // discard the event(s) so the next call does not return early, but keep the latest timestamp
+        gpio_v2_line_event irqEventInfo[4];
+        ret = read(pinCache.fd, irqEventInfo, sizeof(irqEventInfo));
+        for (int i = ret / static_cast<int>(sizeof(gpio_v2_line_event)) - 1; i >= 0; --i) {
+            if (irqEventInfo[i].id == GPIO_V2_LINE_EVENT_FALLING_EDGE) {
+                pthread_mutex_lock(&irq_mutex);
+                pinCache.timestamp = irqEventInfo[i].timestamp_ns;
+                pthread_mutex_unlock(&irq_mutex);
+                break;
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int waitForInterrupt(rf24_gpio_pin_t pin, uint32_t timeout)
+{
+    IrqPinCache& pinCache = cacheIrqPin(pin, "[waitForInterrupt]");
+
+    // the pin's level persists until the event is handled, so don't wait if already LOW
+    gpio_v2_line_values values;
+    values.mask = 1ULL;
+    values.bits = 0ULL;
+    pthread_mutex_lock(&irq_mutex);
+    int ret = ioctl(pinCache.fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values);
+    if (ret < 0) {
+        pthread_mutex_unlock(&irq_mutex);
+        std::string msg = "[waitForInterrupt] Could not get line value; ";
+        msg += strerror(errno);
+        throw IRQException(msg);
+        return 0;
+    }
+    if (!(values.bits & 1ULL)) {
+        pthread_mutex_unlock(&irq_mutex);
+        return 1;
+    }
+
+    if (pinCache.hasHandler()) {
+        // the events are consumed by the dispatcher thread; wait for it to observe the next one
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        unsigned int seqno = pinCache.seqno;
+        ret = 0;
+        while (pinCache.seqno == seqno && ret == 0) {
+            ret = pthread_cond_timedwait(&irq_cond, &irq_mutex, &deadline);
+        }
+        ret = pinCache.seqno != seqno;
+        pthread_mutex_unlock(&irq_mutex);
+        return ret;
+    }
+    pthread_mutex_unlock(&irq_mutex);
+
+    return consumeEvents(pinCache, static_cast<int>(timeout), "[waitForInterrupt]");
+}
+
+uint64_t getInterruptTime(rf24_gpio_pin_t pin)
+{
+    IrqPinCache& pinCache = cacheIrqPin(pin, "[getInterruptTime]");
+    if (!pinCache.hasHandler()) {
+        consumeEvents(pinCache, 0, "[getInterruptTime]"); // collect the pending events without blocking
+    }
+    pthread_mutex_lock(&irq_mutex);
+    uint64_t timestamp = pinCache.timestamp;
+    pthread_mutex_unlock(&irq_mutex);
+    return timestamp;
+}
+
 void rfNoInterrupts()
 {
 }
@@ -181,3 +485,11 @@ void rfInterrupts()
 #ifdef __cplusplus
 }
 #endif
+
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void* context, const rf24_irq_event& event), void* context)
+{
+    IrqPinCache irqPinCache;
+    irqPinCache.contextFunction = function;
+    irqPinCache.context = context;
+    return attachHandler(pin, mode, irqPinCache);
+}
@@ -4,7 +4,6 @@
 #ifndef RF24_UTILITY_SPIDEV_INTERRUPT_H_
 #define RF24_UTILITY_SPIDEV_INTERRUPT_H_
 
-#include <pthread.h> // pthread_t
 #include <stdexcept>
 #include "gpio.h" // rf24_gpio_pin_t
 
@@ -12,6 +11,20 @@
 #define INT_EDGE_RISING  GPIO_V2_LINE_FLAG_EDGE_RISING
 #define INT_EDGE_BOTH    GPIO_V2_LINE_FLAG_EDGE_FALLING | GPIO_V2_LINE_FLAG_EDGE_RISING
 
+// waitForInterrupt() is available
+#define IRQ_HAS_WAIT
+
+// getInterruptTime() is available
+#define IRQ_HAS_TIMESTAMP
+
+// attachInterrupt() accepts a handler with a context pointer & event details
+#define IRQ_HAS_CONTEXT
+
+#ifndef IRQ_EVENT_BUFFER_SIZE
+    // the number of events the kernel queues for each pin (all are handled with 1 wakeup)
+    #define IRQ_EVENT_BUFFER_SIZE 16
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,30 +39,93 @@ public:
     }
 };
 
+/** Details of an edge detected on a pin (passed to a handler attached with a context pointer). */
+struct rf24_irq_event
+{
+    /// The pin that changed
+    rf24_gpio_pin_t pin;
+
+    /// The detected edge (`INT_EDGE_FALLING` or `INT_EDGE_RISING`)
+    int edge;
+
+    /// The sequence number of the event on this pin (assigned by the kernel)
+    unsigned int seqno;
+
+    /// The number of this pin's events that were detected with this one and are dispatched after it
+    unsigned int pending;
+
+    /// When the edge occurred (in nanoseconds of `CLOCK_MONOTONIC`)
+    uint64_t timestamp;
+};
+
 /** Details related to a certain pin's ISR. */
 struct IrqPinCache
 {
     /// The pin request's file descriptor
     int fd = 0;
 
-    /// The posix thread ID.
-    pthread_t id = 0;
-
     /// The user-designated ISR function (used as a callback)
     void (*function)(void) = nullptr;
+
+    /// The user-designated ISR function that takes a context pointer & the event details
+    void (*contextFunction)(void* context, const rf24_irq_event& event) = nullptr;
+
+    /// The context pointer passed to `contextFunction`
+    void* context = nullptr;
+
+    /// Is a handler attached to the pin (so the dispatcher thread consumes its events)?
+    bool hasHandler() const { return function || contextFunction; }
+
+    /// The number of events observed by the dispatcher thread (used by waitForInterrupt())
+    unsigned int seqno = 0;
+
+    /// When the latest falling edge occurred (in nanoseconds of `CLOCK_MONOTONIC`)
+    uint64_t timestamp = 0;
 };
 
 /**
  * Take the details and create an interrupt handler that will
  * callback to the user-supplied function.
+ *
+ * The events of every pin with an attached handler are multiplexed by a single
+ * dispatcher thread (started on first use), so the handlers are called one at a time.
  */
 int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void));
 
 /**
- * Will cancel the interrupt thread and re-configure the pin for `digitalRead()` use.
+ * Will stop dispatching the pin's events and re-configure the pin for `digitalRead()` use.
+ *
+ * Unless it is called from an interrupt handler, this waits for the pin's handler to return.
  */
 int detachInterrupt(rf24_gpio_pin_t pin);
 
+/**
+ * Block until the pin is driven LOW or the timeout expires.
+ *
+ * This is meant for waiting on the radio's (active LOW) IRQ pin without busy polling.
+ * If an interrupt handler is attached to the pin, then this waits for the dispatcher
+ * thread to observe an event. Otherwise, the pin is requested for detecting falling
+ * edges (on first use) and this sleeps on the pin's event file descriptor.
+ *
+ * @param pin The pin to wait on.
+ * @param timeout The maximum time to wait (in milliseconds).
+ * @returns 1 if the pin is LOW or an event was detected, 0 if the timeout expired.
+ */
+int waitForInterrupt(rf24_gpio_pin_t pin, uint32_t timeout);
+
+/**
+ * Get the time of the latest falling edge on a pin.
+ *
+ * The time is taken from the kernel's line event, so it does not depend on when the
+ * event is handled. Like waitForInterrupt(), the pin is requested for detecting falling
+ * edges on first use, so only the edges that occur after that are timestamped.
+ *
+ * @param pin The pin to check.
+ * @returns The time of the latest falling edge (in nanoseconds of `CLOCK_MONOTONIC`),
+ * or 0 if no edge was detected yet.
+ */
+uint64_t getInterruptTime(rf24_gpio_pin_t pin);
+
 /** Deprecated, no longer functional */
 void rfNoInterrupts();
 
@@ -59,4 +135,20 @@ void rfInterrupts();
 #ifdef __cplusplus
 }
 #endif
+
+/**
+ * Take the details and create an interrupt handler that will callback to the
+ * user-supplied function with the given context pointer and the details of each event.
+ *
+ * This avoids a global object (and a trampoline function) for each handled device.
+ * @code
+ * void handleIrq(void* context, const rf24_irq_event& event)
+ * {
+ *     static_cast<Gateway*>(context)->onIrq(event.timestamp);
+ * }
+ * attachInterrupt(pin, INT_EDGE_FALLING, handleIrq, &gateway);
+ * @endcode
+ */
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void* context, const rf24_irq_event& event), void* context);
+
 #endif // RF24_UTILITY_SPIDEV_INTERRUPT_H_
@@ -167,6 +167,62 @@ void SPI::transfernb(char* txBuf, char* rxBuf, uint32_t len)
     }
 }
 
+void SPI::transferBatch(char* buf, const uint8_t* lengths, uint8_t count)
+{
+    if (count > SPI_BATCH_MAX_FRAMES) {
+        throw SPIException("[SPI::transferBatch] Too many frames in batch");
+    }
+
+    struct spi_ioc_transfer tr[SPI_BATCH_MAX_FRAMES];
+    memset(tr, 0, count * sizeof(tr[0])); // only the used transfers are read by the kernel
+    for (uint8_t i = 0; i < count; ++i) {
+        tr[i].tx_buf = (unsigned long)buf;
+        tr[i].rx_buf = (unsigned long)buf;
+        tr[i].len = lengths[i];
+        tr[i].speed_hz = _spi_speed;
+        tr[i].delay_usecs = 0;
+        tr[i].bits_per_word = RF24_SPIDEV_BITS;
+        tr[i].cs_change = i + 1 < count; // release CSN between frames, but not after the last one
+        buf += lengths[i];
+    }
+
+    // SPI_IOC_MESSAGE(N) expects N to be a constant, so build the request number manually
+    int ret;
+    ret = ioctl(this->fd, _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, SPI_MSGSIZE(count)), tr);
+    if (ret < 1) {
+        std::string msg = "[SPI::transferBatch] Can't send spi message; ";
+        msg += strerror(errno);
+        throw SPIException(msg);
+    }
+}
+
+void SPI::transferGather(const char* const* txBufs, const uint8_t* lengths, uint8_t count, char* rxBuf)
+{
+    if (count > SPI_BATCH_MAX_FRAMES) {
+        throw SPIException("[SPI::transferGather] Too many buffers in frame");
+    }
+
+    struct spi_ioc_transfer tr[SPI_BATCH_MAX_FRAMES];
+    memset(tr, 0, count * sizeof(tr[0]));
+    for (uint8_t i = 0; i < count; ++i) {
+        tr[i].tx_buf = (unsigned long)txBufs[i];
+        tr[i].rx_buf = i ? 0 : (unsigned long)rxBuf; // the driver discards the received bytes without a buffer
+        tr[i].len = lengths[i];
+        tr[i].speed_hz = _spi_speed;
+        tr[i].delay_usecs = 0;
+        tr[i].bits_per_word = RF24_SPIDEV_BITS;
+        tr[i].cs_change = 0; // keep CSN active between buffers
+    }
+
+    int ret;
+    ret = ioctl(this->fd, _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, SPI_MSGSIZE(count)), tr);
+    if (ret < 1) {
+        std::string msg = "[SPI::transferGather] Can't send spi message; ";
+        msg += strerror(errno);
+        throw SPIException(msg);
+    }
+}
+
 void SPI::transfern(char* buf, uint32_t len)
 {
     transfernb(buf, buf, len);
@@ -17,6 +17,15 @@
     #define RF24_SPI_SPEED 10000000
 #endif
 
+// this SPI class can submit several CSN-delimited frames with a single syscall
+#define SPI_HAS_BATCH
+
+/** The maximum number of frames that SPI::transferBatch() can submit at once */
+#define SPI_BATCH_MAX_FRAMES 32
+
+// this SPI class can transmit several buffers as one CSN-delimited frame without copying them
+#define SPI_HAS_GATHER
+
 /** Specific exception for SPI errors */
 class SPIException : public std::runtime_error
 {
@@ -41,6 +50,29 @@ public:
 
     void transfern(char* buf, uint32_t len);
 
+    /**
+     * Transfer several frames with a single `SPI_IOC_MESSAGE()` syscall.
+     * The CSN line is released between each frame.
+     *
+     * @param buf The frames' data stored back to back. Each frame is transferred
+     * in place, so the received bytes overwrite the transmitted bytes.
+     * @param lengths The length of each frame.
+     * @param count The number of frames in @p buf (at most @ref SPI_BATCH_MAX_FRAMES).
+     */
+    void transferBatch(char* buf, const uint8_t* lengths, uint8_t count);
+
+    /**
+     * Transmit several buffers as a single frame with a single `SPI_IOC_MESSAGE()` syscall.
+     * The CSN line is held active for the whole frame, and nothing is copied.
+     *
+     * @param txBufs The buffers to transmit.
+     * @param lengths The length of each buffer.
+     * @param count The number of buffers (at most @ref SPI_BATCH_MAX_FRAMES).
+     * @param rxBuf Stores the bytes received while the first buffer is transmitted.
+     * The bytes received during the other buffers are discarded.
+     */
+    void transferGather(const char* const* txBufs, const uint8_t* lengths, uint8_t count, char* rxBuf);
+
     ~SPI();
 
 private:
@@ -70,6 +70,7 @@ typedef uint16_t rf24_gpio_pin_t;
 #define delay(millisec)          __msleep(millisec)
 #define delayMicroseconds(usec)  __usleep(usec)
 #define millis()                 __millis()
+#define micros()                 __micros()
 
 /**@}*/
 
@@ -0,0 +1,70 @@
+/**
+ * @file RF24_arch_config.h
+ * Configuration of the Virtual driver, which emulates the radio instead of driving one.
+ *
+ * @see air.h
+ */
+#ifndef RF24_UTILITY_VIRTUAL_RF24_ARCH_CONFIG_H_
+#define RF24_UTILITY_VIRTUAL_RF24_ARCH_CONFIG_H_
+
+#define RF24_LINUX
+
+#include <stdint.h> // uint16_t
+#include <stdio.h>  // printf
+#include <string.h> // strlen
+#include "spi.h"
+#include "gpio.h"
+#include "compatibility.h"
+#include "interrupt.h"
+
+#define _BV(x) (1 << (x))
+#define _SPI   spi
+
+#if defined(SPI_HAS_BATCH)
+    // this gets triggered as /utility/Virtual/spi.h defines SPI_HAS_BATCH (unless modified by end-user)
+    #define RF24_SPI_BATCH
+    // the number of bytes that can be queued for a batched SPI transaction
+    #define RF24_SPI_BATCH_SIZE 96
+#endif
+
+#if defined(IRQ_HAS_WAIT)
+    // this gets triggered as /utility/Virtual/interrupt.h defines IRQ_HAS_WAIT (unless modified by end-user)
+    #define RF24_IRQ_WAIT
+#endif
+
+#if defined(IRQ_HAS_CONTEXT)
+    // this gets triggered as /utility/Virtual/interrupt.h defines IRQ_HAS_CONTEXT (unless modified by end-user)
+    #define RF24_IRQ_CONTEXT
+    #include <pthread.h> // pthread_mutex_t (the handler runs in the interrupt dispatcher's thread)
+#endif
+
+#ifdef RF24_DEBUG
+    #define IF_RF24_DEBUG(x) ({ x; })
+#else
+    #define IF_RF24_DEBUG(x)
+#endif
+
+typedef uint16_t prog_uint16_t;
+
+#define PSTR(x)  (x)
+#define printf_P printf
+#define strlen_P strlen
+#define PROGMEM
+#define pgm_read_word(p) (*(const unsigned short*)(p))
+#define PRIPSTR          "%s"
+#define pgm_read_byte(p) (*(const unsigned char*)(p))
+#define pgm_read_ptr(p)  (*(void* const*)(p))
+
+// Function, constant map as a result of migrating from Arduino
+#define LOW                      GPIO::OUTPUT_LOW
+#define HIGH                     GPIO::OUTPUT_HIGH
+#define INPUT                    GPIO::DIRECTION_IN
+#define OUTPUT                   GPIO::DIRECTION_OUT
+#define digitalWrite(pin, value) GPIO::write(pin, value)
+#define pinMode(pin, direction)  GPIO::open(pin, direction)
+#define delay(millisec)          __msleep(millisec)
+#define delayMicroseconds(usec)  __usleep(usec)
+#define millis()                 __millis()
+#define micros()                 __micros()
+
+#endif // RF24_UTILITY_VIRTUAL_RF24_ARCH_CONFIG_H_
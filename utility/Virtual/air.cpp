@@ -0,0 +1,765 @@
+/**
+ * Virtual air implementation
+ */
+#include <errno.h>
+#include <fcntl.h>    // O_* constants
+#include <pthread.h>
+#include <signal.h>   // kill()
+#include <stdlib.h>   // getenv(), atoi(), rand_r()
+#include <string.h>   // memset(), memcpy(), memcmp()
+#include <sys/mman.h> // shm_open(), mmap()
+#include <sys/stat.h> // fstat()
+#include <time.h>     // clock_gettime(), nanosleep()
+#include <unistd.h>   // ftruncate(), getpid(), close()
+#include <map>
+#include <mutex>
+#include "../../nRF24L01.h"
+#include "spi.h" // SPIException
+#include "air.h"
+
+#ifndef _BV
+    #define _BV(x) (1 << (x))
+#endif
+
+#define AIR_MAGIC     0x52463234UL // "RF24"
+#define AIR_SETTLE_NS 130000ULL    // the PLL settling time when entering TX or RX mode
+
+struct AirPayload
+{
+    uint8_t length;
+    uint8_t pipe; // the pipe of an ACK payload (or the pipe that received an RX payload)
+    uint8_t noAck;
+    uint8_t data[32];
+};
+
+enum AirChipState
+{
+    CHIP_IDLE,    // not transmitting
+    CHIP_SENDING, // eventTime is the end of a transmission attempt
+    CHIP_ACKED,   // eventTime is the end of the received ACK packet
+    CHIP_FAILED,  // eventTime is the end of the last attempt's ACK timeout
+};
+
+struct AirChip
+{
+    int32_t owner; // the process using the radio (0 if unused)
+    uint8_t bus;
+    uint8_t regs[0x20];
+    uint8_t rxAddr0[5];
+    uint8_t rxAddr1[5];
+    uint8_t txAddr[5];
+    uint8_t ce;
+    uint8_t rpd;
+    AirPayload rx[3];
+    uint8_t rxCount;
+    uint8_t rxWidth; // the width of the last payload read (reported while the RX FIFO is empty)
+    AirPayload tx[3];
+    uint8_t txCount;
+    uint8_t reuse;
+    uint8_t state;
+    uint8_t attempts;
+    uint64_t eventTime;
+    AirPayload ack; // the ACK payload received for the current transmission
+    uint8_t hasAck;
+    uint64_t irqTime; // when the IRQ pin last fell
+};
+
+struct AirMap
+{
+    uint32_t magic; // set once the creator is done initializing
+    uint32_t size;  // guards against a stale object left by an incompatible build
+    pthread_mutex_t mutex;
+    pthread_cond_t changed; // broadcast whenever the state of any radio changes
+    AirChip chips[RF24_VIRTUAL_MAX_RADIOS];
+};
+
+static AirMap* air = nullptr;
+static std::once_flag air_once;
+static unsigned int loss_percent = 0;
+static unsigned int loss_seed = 0;
+
+// process-local state
+static std::mutex local_mutex;
+static std::map<rf24_gpio_pin_t, std::pair<int, bool>> pin_map; // pin number -> (radio, isCe)
+static int pending_ce = -1;                                    // the radio awaiting its CE pin
+static int last_radio = -1;                                    // the radio begun last
+
+static uint64_t now_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static void map_air()
+{
+    const char* name = getenv("RF24_VIRTUAL_AIR");
+    if (!name || !*name) {
+        name = RF24_VIRTUAL_AIR;
+    }
+    const char* loss = getenv("RF24_VIRTUAL_LOSS");
+    if (loss) {
+        loss_percent = static_cast<unsigned int>(atoi(loss));
+    }
+    loss_seed = static_cast<unsigned int>(getpid() ^ now_ns());
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0666);
+    bool creator = fd >= 0;
+    if (!creator) {
+        fd = shm_open(name, O_RDWR, 0666);
+    }
+    if (fd < 0) {
+        throw SPIException(std::string("[VirtualAir] Can't open shared memory object ") + name);
+    }
+    if (creator) {
+        fchmod(fd, 0666); // ignore the umask, so other users can share the air
+        if (ftruncate(fd, sizeof(AirMap)) < 0) {
+            close(fd);
+            throw SPIException("[VirtualAir] Can't resize the shared memory object");
+        }
+    }
+    else {
+        // wait for the creator to resize the object
+        struct stat info;
+        for (int i = 0; fstat(fd, &info) == 0 && info.st_size == 0 && i < 1000; ++i) {
+            timespec pause = {0, 1000000};
+            nanosleep(&pause, NULL);
+        }
+        if (info.st_size != sizeof(AirMap)) {
+            close(fd);
+            throw SPIException(std::string("[VirtualAir] Incompatible shared memory object; remove /dev/shm") + name);
+        }
+    }
+
+    void* mapped = mmap(NULL, sizeof(AirMap), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw SPIException("[VirtualAir] Can't map the shared memory object");
+    }
+    AirMap* map = static_cast<AirMap*>(mapped);
+
+    if (creator) {
+        pthread_mutexattr_t mutexAttr;
+        pthread_mutexattr_init(&mutexAttr);
+        pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&map->mutex, &mutexAttr);
+        pthread_mutexattr_destroy(&mutexAttr);
+
+        pthread_condattr_t condAttr;
+        pthread_condattr_init(&condAttr);
+        pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+        pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+        pthread_cond_init(&map->changed, &condAttr);
+        pthread_condattr_destroy(&condAttr);
+
+        map->size = sizeof(AirMap);
+        __atomic_store_n(&map->magic, AIR_MAGIC, __ATOMIC_RELEASE);
+    }
+    else {
+        for (int i = 0; __atomic_load_n(&map->magic, __ATOMIC_ACQUIRE) != AIR_MAGIC && i < 1000; ++i) {
+            timespec pause = {0, 1000000};
+            nanosleep(&pause, NULL);
+        }
+        if (map->magic != AIR_MAGIC || map->size != sizeof(AirMap)) {
+            munmap(mapped, sizeof(AirMap));
+            throw SPIException(std::string("[VirtualAir] Incompatible shared memory object; remove /dev/shm") + name);
+        }
+    }
+    air = map;
+}
+
+// A scoped lock of the air's (robust) mutex
+struct AirLock
+{
+    AirLock()
+    {
+        std::call_once(air_once, map_air);
+        if (pthread_mutex_lock(&air->mutex) == EOWNERDEAD) {
+            pthread_mutex_consistent(&air->mutex); // a process died while using the air
+        }
+    }
+
+    ~AirLock()
+    {
+        pthread_mutex_unlock(&air->mutex);
+    }
+};
+
+static AirChip& get_chip(int radio)
+{
+    if (radio < 0 || radio >= RF24_VIRTUAL_MAX_RADIOS) {
+        throw SPIException("[VirtualAir] The radio was not begun");
+    }
+    return air->chips[radio];
+}
+
+/****************************************************************************/
+// register helpers
+
+static void reset_chip(AirChip& chip)
+{
+    memset(&chip, 0, sizeof(AirChip));
+    chip.regs[NRF_CONFIG] = 0x08;
+    chip.regs[EN_AA] = 0x3F;
+    chip.regs[EN_RXADDR] = 0x03;
+    chip.regs[SETUP_AW] = 0x03;
+    chip.regs[SETUP_RETR] = 0x03;
+    chip.regs[RF_CH] = 0x02;
+    chip.regs[RF_SETUP] = 0x0F;
+    chip.regs[RX_ADDR_P2] = 0xC3;
+    chip.regs[RX_ADDR_P3] = 0xC4;
+    chip.regs[RX_ADDR_P4] = 0xC5;
+    chip.regs[RX_ADDR_P5] = 0xC6;
+    memset(chip.rxAddr0, 0xE7, 5);
+    memset(chip.rxAddr1, 0xC2, 5);
+    memset(chip.txAddr, 0xE7, 5);
+}
+
+static uint8_t addr_width(const AirChip& chip)
+{
+    uint8_t width = chip.regs[SETUP_AW] & 3;
+    return width ? width + 2 : 3;
+}
+
+static bool powered(const AirChip& chip)
+{
+    return chip.regs[NRF_CONFIG] & _BV(PWR_UP);
+}
+
+static bool listening(const AirChip& chip)
+{
+    return powered(chip) && (chip.regs[NRF_CONFIG] & _BV(PRIM_RX)) && chip.ce;
+}
+
+static bool dynamic_payloads(const AirChip& chip, uint8_t pipe)
+{
+    return (chip.regs[FEATURE] & _BV(EN_DPL)) && (chip.regs[DYNPD] & _BV(pipe));
+}
+
+static uint8_t crc_length(const AirChip& chip)
+{
+    // auto-ack forces the CRC on
+    if (!(chip.regs[NRF_CONFIG] & _BV(EN_CRC)) && !(chip.regs[EN_AA] & 0x3F)) {
+        return 0;
+    }
+    return chip.regs[NRF_CONFIG] & _BV(CRCO) ? 2 : 1;
+}
+
+// the time (in nanoseconds) a packet with the given payload length spends on air
+static uint64_t air_time(const AirChip& chip, uint8_t length)
+{
+    bool fast = chip.regs[RF_SETUP] & _BV(RF_DR_HIGH);
+    uint64_t bits = (fast + 1U + addr_width(chip) + length + crc_length(chip)) * 8U + 9U; // 9 bit packet control field
+    if (chip.regs[RF_SETUP] & _BV(RF_DR_LOW)) {
+        return bits * 4000; // 250 kbps
+    }
+    return fast ? bits * 500 : bits * 1000;
+}
+
+static uint64_t retry_delay(const AirChip& chip)
+{
+    return ((chip.regs[SETUP_RETR] >> ARD) + 1ULL) * 250000ULL;
+}
+
+static uint8_t status_of(const AirChip& chip)
+{
+    uint8_t pipe = chip.rxCount ? chip.rx[0].pipe : 7;
+    return (chip.regs[NRF_STATUS] & 0x70) | (pipe << RX_P_NO) | (chip.txCount == 3 ? _BV(TX_FULL) : 0);
+}
+
+static uint8_t fifo_status_of(const AirChip& chip)
+{
+    return (chip.reuse ? _BV(TX_REUSE) : 0) | (chip.txCount == 3 ? _BV(FIFO_FULL) : 0) | (chip.txCount ? 0 : _BV(TX_EMPTY))
+           | (chip.rxCount == 3 ? _BV(RX_FULL) : 0) | (chip.rxCount ? 0 : _BV(RX_EMPTY));
+}
+
+static bool irq_level(const AirChip& chip)
+{
+    return !(chip.regs[NRF_STATUS] & 0x70 & ~chip.regs[NRF_CONFIG]);
+}
+
+// set STATUS flags, remembering when they drive the IRQ pin LOW
+static void raise_flags(AirChip& chip, uint8_t flags, uint64_t when)
+{
+    bool wasHigh = irq_level(chip);
+    chip.regs[NRF_STATUS] |= flags;
+    if (wasHigh && !irq_level(chip)) {
+        chip.irqTime = when;
+    }
+}
+
+// the IRQ levels of all radios (1 bit each) to tell if waiting processes need waking
+static_assert(RF24_VIRTUAL_MAX_RADIOS <= 32, "irq_levels() needs a wider type");
+static uint32_t irq_levels()
+{
+    uint32_t levels = 0;
+    for (int i = 0; i < RF24_VIRTUAL_MAX_RADIOS; ++i) {
+        if (air->chips[i].owner && irq_level(air->chips[i])) {
+            levels |= 1UL << i;
+        }
+    }
+    return levels;
+}
+
+/****************************************************************************/
+// ESB emulation
+
+// begin transmitting the top of the TX FIFO if the radio is ready to
+static bool start_tx(AirChip& chip, uint64_t when)
+{
+    if (chip.state != CHIP_IDLE || !chip.txCount || !powered(chip) || (chip.regs[NRF_CONFIG] & _BV(PRIM_RX))
+        || (chip.regs[NRF_STATUS] & _BV(MAX_RT))) {
+        return false;
+    }
+    chip.state = CHIP_SENDING;
+    chip.attempts = 0;
+    chip.hasAck = 0;
+    chip.eventTime = when + AIR_SETTLE_NS + air_time(chip, chip.tx[0].length);
+    return true;
+}
+
+static bool address_matches(const AirChip& rx, uint8_t pipe, const uint8_t* address, uint8_t width)
+{
+    if (pipe == 0) {
+        return memcmp(rx.rxAddr0, address, width) == 0;
+    }
+    // pipes 2-5 only differ from pipe 1 by their LSB
+    uint8_t lsb = pipe == 1 ? rx.rxAddr1[0] : rx.regs[RX_ADDR_P0 + pipe];
+    return lsb == address[0] && memcmp(rx.rxAddr1 + 1, address + 1, width - 1) == 0;
+}
+
+/**
+ * Deliver the packet transmitted by chips[sender] to every radio listening for it.
+ * @returns `true` if a receiver responded with an ACK packet.
+ */
+static bool deliver(int sender, uint64_t when)
+{
+    AirChip& tx = air->chips[sender];
+    const AirPayload& packet = tx.tx[0];
+    uint8_t width = addr_width(tx);
+    bool noAck = packet.noAck && (tx.regs[FEATURE] & _BV(EN_DYN_ACK));
+    bool acked = false;
+
+    for (int i = 0; i < RF24_VIRTUAL_MAX_RADIOS; ++i) {
+        AirChip& rx = air->chips[i];
+        if (i == sender || !rx.owner || !listening(rx) || rx.regs[RF_CH] != tx.regs[RF_CH]) {
+            continue;
+        }
+        rx.rpd = 1; // any carrier on the channel is detected
+        if ((rx.regs[RF_SETUP] & (_BV(RF_DR_LOW) | _BV(RF_DR_HIGH))) != (tx.regs[RF_SETUP] & (_BV(RF_DR_LOW) | _BV(RF_DR_HIGH)))
+            || addr_width(rx) != width || crc_length(rx) != crc_length(tx)) {
+            continue;
+        }
+        uint8_t pipe = 0;
+        while (pipe < 6 && !((rx.regs[EN_RXADDR] & _BV(pipe)) && address_matches(rx, pipe, tx.txAddr, width))) {
+            pipe++;
+        }
+        if (pipe == 6 || dynamic_payloads(rx, pipe) != dynamic_payloads(tx, 0)
+            || (!dynamic_payloads(rx, pipe) && packet.length != rx.regs[RX_PW_P0 + pipe])) {
+            continue; // the packet would fail the receiver's CRC check
+        }
+        if (loss_percent && static_cast<unsigned int>(rand_r(&loss_seed) % 100) < loss_percent) {
+            continue;
+        }
+        if (rx.rxCount == 3) {
+            continue; // a full RX FIFO drops the packet without an ACK
+        }
+
+        AirPayload& stored = rx.rx[rx.rxCount++];
+        stored = packet;
+        stored.pipe = pipe;
+        raise_flags(rx, _BV(RX_DR), when);
+
+        if (!acked && !noAck && (rx.regs[EN_AA] & _BV(pipe))) {
+            acked = true;
+            if ((rx.regs[FEATURE] & _BV(EN_ACK_PAY)) && (rx.regs[FEATURE] & _BV(EN_DPL))) {
+                // send the first ACK payload queued for the pipe
+                for (uint8_t j = 0; j < rx.txCount; ++j) {
+                    if (rx.tx[j].pipe == pipe) {
+                        tx.ack = rx.tx[j];
+                        tx.hasAck = 1;
+                        memmove(rx.tx + j, rx.tx + j + 1, (rx.txCount - j - 1) * sizeof(AirPayload));
+                        rx.txCount--;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return acked;
+}
+
+// evaluate the pending event of chips[index]
+static void process_event(int index)
+{
+    AirChip& chip = air->chips[index];
+    uint64_t when = chip.eventTime;
+    bool expectAck = !(chip.tx[0].noAck && (chip.regs[FEATURE] & _BV(EN_DYN_ACK))) && (chip.regs[EN_AA] & _BV(ENAA_P0));
+
+    if (chip.state == CHIP_SENDING) {
+        bool acked = deliver(index, when);
+        if (!expectAck) {
+            chip.state = CHIP_ACKED; // done right away
+        }
+        else if (acked && memcmp(chip.rxAddr0, chip.txAddr, addr_width(chip)) == 0) {
+            chip.state = CHIP_ACKED;
+            chip.eventTime = when + AIR_SETTLE_NS + air_time(chip, chip.hasAck ? chip.ack.length : 0);
+            return;
+        }
+        else if (chip.attempts < (chip.regs[SETUP_RETR] & 0x0F)) {
+            chip.attempts++;
+            chip.hasAck = 0;
+            chip.eventTime = when + retry_delay(chip) + air_time(chip, chip.tx[0].length);
+            return;
+        }
+        else {
+            chip.state = CHIP_FAILED;
+            chip.eventTime = when + retry_delay(chip);
+            return;
+        }
+    }
+    else if (chip.state == CHIP_FAILED) {
+        // give up; the payload stays in the TX FIFO
+        chip.state = CHIP_IDLE;
+        uint8_t lost = chip.regs[OBSERVE_TX] >> PLOS_CNT;
+        chip.regs[OBSERVE_TX] = ((lost < 15 ? lost + 1 : 15) << PLOS_CNT) | chip.attempts;
+        raise_flags(chip, _BV(MAX_RT), when);
+        return;
+    }
+
+    // the transmission succeeded
+    chip.state = CHIP_IDLE;
+    chip.regs[OBSERVE_TX] = (chip.regs[OBSERVE_TX] & 0xF0) | chip.attempts;
+    uint8_t flags = _BV(TX_DS);
+    if (chip.hasAck && chip.rxCount < 3) {
+        AirPayload& stored = chip.rx[chip.rxCount++];
+        stored = chip.ack;
+        stored.pipe = 0;
+        flags |= _BV(RX_DR);
+    }
+    raise_flags(chip, flags, when);
+    chip.hasAck = 0;
+    if (!chip.reuse) {
+        memmove(chip.tx, chip.tx + 1, (chip.txCount - 1) * sizeof(AirPayload));
+        chip.txCount--;
+    }
+    if (chip.ce) {
+        start_tx(chip, when);
+    }
+}
+
+/**
+ * Evaluate all events that are due (in chronological order).
+ * @returns `true` if any event was evaluated.
+ */
+static bool advance(uint64_t now)
+{
+    bool changed = false;
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < RF24_VIRTUAL_MAX_RADIOS; ++i) {
+            const AirChip& chip = air->chips[i];
+            if (chip.owner && chip.state != CHIP_IDLE && chip.eventTime <= now
+                && (next < 0 || chip.eventTime < air->chips[next].eventTime)) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            return changed;
+        }
+        process_event(next);
+        changed = true;
+    }
+}
+
+// the time of the next pending event (or 0 if there are none)
+static uint64_t next_event()
+{
+    uint64_t next = 0;
+    for (int i = 0; i < RF24_VIRTUAL_MAX_RADIOS; ++i) {
+        const AirChip& chip = air->chips[i];
+        if (chip.owner && chip.state != CHIP_IDLE && (!next || chip.eventTime < next)) {
+            next = chip.eventTime;
+        }
+    }
+    return next;
+}
+
+// execute a single SPI command (buf[0]) on a radio
+static void execute(AirChip& chip, uint8_t* buf, uint32_t len, uint64_t now)
+{
+    uint8_t command = buf[0];
+    buf[0] = status_of(chip);
+    uint8_t* data = buf + 1;
+    uint32_t size = len ? len - 1 : 0;
+
+    if (command < W_REGISTER) {
+        uint8_t reg = command & REGISTER_MASK;
+        const uint8_t* address = reg == RX_ADDR_P0 ? chip.rxAddr0 : (reg == RX_ADDR_P1 ? chip.rxAddr1 : (reg == TX_ADDR ? chip.txAddr : NULL));
+        for (uint32_t i = 0; i < size; ++i) {
+            if (address) {
+                data[i] = i < 5 ? address[i] : 0;
+            }
+            else if (reg == NRF_STATUS) {
+                data[i] = status_of(chip);
+            }
+            else if (reg == FIFO_STATUS) {
+                data[i] = fifo_status_of(chip);
+            }
+            else if (reg == RPD) {
+                data[i] = chip.rpd;
+            }
+            else {
+                data[i] = chip.regs[reg];
+            }
+        }
+    }
+    else if (command < 0x40) {
+        uint8_t reg = command & REGISTER_MASK;
+        uint8_t* address = reg == RX_ADDR_P0 ? chip.rxAddr0 : (reg == RX_ADDR_P1 ? chip.rxAddr1 : (reg == TX_ADDR ? chip.txAddr : NULL));
+        if (address) {
+            memcpy(address, data, size < 5 ? size : 5);
+        }
+        else if (size) {
+            uint8_t value = data[0];
+            if (reg == NRF_STATUS) {
+                chip.regs[NRF_STATUS] &= ~(value & 0x70); // write 1 to clear
+                if ((value & _BV(MAX_RT)) && chip.ce) {
+                    start_tx(chip, now);
+                }
+            }
+            else if (reg == NRF_CONFIG) {
+                bool wasListening = listening(chip);
+                bool wasHigh = irq_level(chip);
+                chip.regs[NRF_CONFIG] = value & 0x7F;
+                if (wasHigh && !irq_level(chip)) {
+                    chip.irqTime = now; // a pending event was unmasked
+                }
+                if (!wasListening && listening(chip)) {
+                    chip.rpd = 0;
+                }
+                if (chip.ce) {
+                    start_tx(chip, now);
+                }
+            }
+            else if (reg == RF_CH) {
+                chip.regs[RF_CH] = value & 0x7F;
+                chip.regs[OBSERVE_TX] &= 0x0F; // PLOS_CNT is reset by writing RF_CH
+            }
+            else if (reg != OBSERVE_TX && reg != RPD && reg != FIFO_STATUS && reg < 0x1E) {
+                chip.regs[reg] = value;
+            }
+        }
+    }
+    else if (command == R_RX_PL_WID) {
+        if (size) {
+            data[0] = chip.rxCount ? chip.rx[0].length : chip.rxWidth;
+        }
+    }
+    else if (command == R_RX_PAYLOAD) {
+        // each frame pops exactly 1 payload; bytes read past its end are 0
+        uint32_t i = 0;
+        if (chip.rxCount) {
+            uint8_t length = chip.rx[0].length;
+            for (; i < length && i < size; ++i) {
+                data[i] = chip.rx[0].data[i];
+            }
+            chip.rxWidth = length;
+            memmove(chip.rx, chip.rx + 1, (chip.rxCount - 1) * sizeof(AirPayload));
+            chip.rxCount--;
+        }
+        for (; i < size; ++i) {
+            data[i] = 0;
+        }
+    }
+    else if (command == W_TX_PAYLOAD || command == W_TX_PAYLOAD_NO_ACK || (command & 0xF8) == W_ACK_PAYLOAD) {
+        if (chip.txCount < 3) {
+            AirPayload& payload = chip.tx[chip.txCount++];
+            payload.length = size < 32 ? size : 32;
+            memcpy(payload.data, data, payload.length);
+            payload.noAck = command == W_TX_PAYLOAD_NO_ACK;
+            payload.pipe = (command & 0xF8) == W_ACK_PAYLOAD ? command & 7 : 0;
+            chip.reuse = 0;
+            if (chip.ce) {
+                start_tx(chip, now);
+            }
+        }
+    }
+    else if (command == FLUSH_TX) {
+        chip.txCount = 0;
+        chip.reuse = 0;
+        chip.state = CHIP_IDLE;
+    }
+    else if (command == FLUSH_RX) {
+        chip.rxCount = 0;
+    }
+    else if (command == REUSE_TX_PL) {
+        chip.reuse = chip.txCount > 0;
+    }
+    // ACTIVATE and NOP do nothing on a nRF24L01+
+}
+
+/****************************************************************************/
+
+int VirtualAir::attach(uint8_t bus)
+{
+    AirLock lock;
+    int found = -1;
+    for (int i = 0; i < RF24_VIRTUAL_MAX_RADIOS; ++i) {
+        AirChip& chip = air->chips[i];
+        if (chip.owner && kill(chip.owner, 0) < 0 && errno == ESRCH) {
+            chip.owner = 0; // the process using the radio died
+        }
+        if (!chip.owner && found < 0) {
+            found = i;
+        }
+    }
+    if (found < 0) {
+        throw SPIException("[VirtualAir] All virtual radios are in use");
+    }
+    AirChip& chip = air->chips[found];
+    reset_chip(chip);
+    chip.owner = getpid();
+    chip.bus = bus;
+
+    std::lock_guard<std::mutex> guard(local_mutex);
+    pending_ce = found;
+    last_radio = found;
+    return found;
+}
+
+void VirtualAir::detach(int radio)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    chip.owner = 0;
+    chip.state = CHIP_IDLE;
+    pthread_cond_broadcast(&air->changed);
+
+    std::lock_guard<std::mutex> guard(local_mutex);
+    for (std::map<rf24_gpio_pin_t, std::pair<int, bool>>::iterator i = pin_map.begin(); i != pin_map.end();) {
+        if (i->second.first == radio) {
+            i = pin_map.erase(i);
+        }
+        else {
+            ++i;
+        }
+    }
+    if (pending_ce == radio) {
+        pending_ce = -1;
+    }
+    if (last_radio == radio) {
+        last_radio = -1;
+    }
+}
+
+void VirtualAir::transfer(int radio, uint8_t* buf, uint32_t len)
+{
+    uint8_t length = static_cast<uint8_t>(len);
+    transferBatch(radio, buf, &length, 1);
+}
+
+void VirtualAir::transferBatch(int radio, uint8_t* buf, const uint8_t* lengths, uint8_t count)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    uint64_t now = now_ns();
+    bool changed = advance(now);
+    uint32_t levels = irq_levels();
+    uint64_t event = next_event();
+    for (uint8_t i = 0; i < count; buf += lengths[i++]) {
+        execute(chip, buf, lengths[i], now);
+    }
+    // most transactions (like polling the STATUS byte) don't concern waiting processes
+    if (changed || levels != irq_levels() || event != next_event()) {
+        pthread_cond_broadcast(&air->changed);
+    }
+}
+
+void VirtualAir::setCe(int radio, bool level)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    uint64_t now = now_ns();
+    advance(now);
+    if (level && !chip.ce) {
+        chip.ce = 1;
+        if (listening(chip)) {
+            chip.rpd = 0;
+        }
+        start_tx(chip, now); // a rising edge sends a payload from standby-I
+    }
+    else if (!level) {
+        chip.ce = 0; // an ongoing transmission still finishes
+    }
+    pthread_cond_broadcast(&air->changed);
+}
+
+bool VirtualAir::getIrq(int radio)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    if (advance(now_ns())) {
+        pthread_cond_broadcast(&air->changed);
+    }
+    return irq_level(chip);
+}
+
+uint64_t VirtualAir::getIrqTime(int radio)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    if (advance(now_ns())) {
+        pthread_cond_broadcast(&air->changed);
+    }
+    return chip.irqTime;
+}
+
+bool VirtualAir::waitIrq(int radio, bool level, uint32_t timeout)
+{
+    AirLock lock;
+    AirChip& chip = get_chip(radio);
+    uint64_t deadline = now_ns() + timeout * 1000000ULL;
+    for (;;) {
+        uint64_t now = now_ns();
+        if (advance(now)) {
+            pthread_cond_broadcast(&air->changed);
+        }
+        if (irq_level(chip) == level) {
+            return true;
+        }
+        if (now >= deadline || !chip.owner) {
+            return false;
+        }
+        // sleep until something changes or the next event is due
+        uint64_t wake = next_event();
+        if (!wake || wake > deadline) {
+            wake = deadline;
+        }
+        timespec until = {static_cast<time_t>(wake / 1000000000ULL), static_cast<long>(wake % 1000000000ULL)};
+        if (pthread_cond_timedwait(&air->changed, &air->mutex, &until) == EOWNERDEAD) {
+            pthread_mutex_consistent(&air->mutex);
+        }
+    }
+}
+
+int VirtualAir::bindPin(rf24_gpio_pin_t pin, bool output, bool* isCe)
+{
+    std::lock_guard<std::mutex> guard(local_mutex);
+    std::map<rf24_gpio_pin_t, std::pair<int, bool>>::iterator cached = pin_map.find(pin);
+    if (cached == pin_map.end()) {
+        if (output && pending_ce >= 0) {
+            cached = pin_map.insert(std::make_pair(pin, std::make_pair(pending_ce, true))).first;
+            pending_ce = -1;
+        }
+        else if (!output && last_radio >= 0) {
+            cached = pin_map.insert(std::make_pair(pin, std::make_pair(last_radio, false))).first;
+        }
+        else {
+            return -1;
+        }
+    }
+    *isCe = cached->second.second;
+    return cached->second.first;
+}
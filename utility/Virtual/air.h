@@ -0,0 +1,102 @@
+/**
+ * @file air.h
+ * An emulation of nRF24L01+ radios sharing a virtual "air".
+ *
+ * Every emulated radio lives in a POSIX shared memory object, so radios driven by
+ * separate processes (ie a TX example and an RX example) can talk to each other.
+ * The emulation covers the register map, the 3 level TX/RX FIFOs, Enhanced ShockBurst
+ * auto-ack and auto-retransmit timing, dynamic payloads and ACK payloads.
+ *
+ * Nothing runs in the background. Pending events (like a transmission finishing) are
+ * evaluated against `CLOCK_MONOTONIC` whenever any process accesses the air.
+ */
+#ifndef RF24_UTILITY_VIRTUAL_AIR_H_
+#define RF24_UTILITY_VIRTUAL_AIR_H_
+
+#include <stdint.h>
+#include "gpio.h" // rf24_gpio_pin_t
+
+#ifndef RF24_VIRTUAL_AIR
+    /**
+     * The name of the shared memory object holding the emulated radios. This can also be
+     * overridden at runtime with the `RF24_VIRTUAL_AIR` environment variable, which allows
+     * several independent groups of radios on the same machine.
+     */
+    #define RF24_VIRTUAL_AIR "/rf24_virtual_air"
+#endif
+
+#ifndef RF24_VIRTUAL_MAX_RADIOS
+    /** The number of radios that can share the air. */
+    #define RF24_VIRTUAL_MAX_RADIOS 16
+#endif
+
+/**
+ * Access to the emulated radios.
+ *
+ * A radio is identified by its index in the shared air. The GPIO pins of the emulated
+ * radios are bound to pin numbers by the process using them:
+ * - The first output pin opened after SPI::begin() is the radio's CE pin.
+ * - Any other pin that is read (or waited on) is the IRQ pin of the radio begun last.
+ *
+ * The `RF24_VIRTUAL_LOSS` environment variable can be set to a percentage of
+ * transmissions that are lost (to exercise the auto-retransmit logic).
+ */
+class VirtualAir
+{
+public:
+    /**
+     * Claim a radio for this process.
+     * @param bus The SPI bus number (only used to describe the radio).
+     * @returns The radio's index.
+     */
+    static int attach(uint8_t bus);
+
+    /** Release a radio claimed with attach(). */
+    static void detach(int radio);
+
+    /**
+     * Perform a CSN-delimited SPI transaction with a radio.
+     * @param radio The radio's index.
+     * @param buf The bytes to send. This is overwritten with the bytes received.
+     * @param len The number of bytes in @p buf.
+     */
+    static void transfer(int radio, uint8_t* buf, uint32_t len);
+
+    /**
+     * Perform several CSN-delimited SPI transactions at once.
+     * @see SPI::transferBatch()
+     */
+    static void transferBatch(int radio, uint8_t* buf, const uint8_t* lengths, uint8_t count);
+
+    /** Drive a radio's CE pin. */
+    static void setCe(int radio, bool level);
+
+    /** @returns The level of a radio's (active LOW) IRQ pin. */
+    static bool getIrq(int radio);
+
+    /**
+     * @returns When a radio's IRQ pin last fell (in nanoseconds of `CLOCK_MONOTONIC`),
+     * or 0 if it never did.
+     */
+    static uint64_t getIrqTime(int radio);
+
+    /**
+     * Block until a radio's IRQ pin has the given level or the timeout expires.
+     * @param radio The radio's index.
+     * @param level The awaited level.
+     * @param timeout The maximum time to wait (in milliseconds).
+     * @returns `true` if the pin has the awaited level.
+     */
+    static bool waitIrq(int radio, bool level, uint32_t timeout);
+
+    /**
+     * Bind a GPIO pin to the radio it belongs to.
+     * @param pin The pin number used by the program.
+     * @param output Is the pin opened as an output?
+     * @param[out] isCe Set to `true` if the pin is a radio's CE pin, `false` for an IRQ pin.
+     * @returns The radio's index or -1 if the pin does not belong to an emulated radio.
+     */
+    static int bindPin(rf24_gpio_pin_t pin, bool output, bool* isCe);
+};
+
+#endif // RF24_UTILITY_VIRTUAL_AIR_H_
@@ -0,0 +1,30 @@
+#include "../common/timing.h" // rf24_delay_us(), rf24_delay_ms(), rf24_millis(), rf24_micros()
+#include "compatibility.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void __msleep(int millisec)
+{
+    rf24_delay_ms(static_cast<uint32_t>(millisec));
+}
+
+void __usleep(int microsec)
+{
+    rf24_delay_us(static_cast<uint32_t>(microsec));
+}
+
+uint32_t __millis()
+{
+    return rf24_millis();
+}
+
+uint32_t __micros()
+{
+    return rf24_micros();
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+#ifndef RF24_UTILITY_VIRTUAL_COMPATIBLITY_H_
+#define RF24_UTILITY_VIRTUAL_COMPATIBLITY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h> // for uintXX_t types
+
+void __msleep(int millisec);
+
+void __usleep(int microsec);
+
+uint32_t __millis();
+
+uint32_t __micros();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RF24_UTILITY_VIRTUAL_COMPATIBLITY_H_
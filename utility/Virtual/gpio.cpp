@@ -0,0 +1,54 @@
+/**
+ * @file gpio.cpp
+ * GPIO pins of the emulated radios
+ */
+#include <map>
+#include <mutex>
+#include "air.h"
+#include "gpio.h"
+
+static std::mutex gpio_mutex;
+static std::map<rf24_gpio_pin_t, int> gpio_values; // the values of pins not bound to a radio
+
+GPIO::GPIO()
+{
+}
+
+GPIO::~GPIO()
+{
+}
+
+void GPIO::open(rf24_gpio_pin_t port, int DDR)
+{
+    bool isCe;
+    VirtualAir::bindPin(port, DDR == DIRECTION_OUT, &isCe);
+}
+
+void GPIO::close(rf24_gpio_pin_t port)
+{
+    std::lock_guard<std::mutex> lock(gpio_mutex);
+    gpio_values.erase(port);
+}
+
+int GPIO::read(rf24_gpio_pin_t port)
+{
+    bool isCe;
+    int radio = VirtualAir::bindPin(port, false, &isCe);
+    if (radio >= 0 && !isCe) {
+        return VirtualAir::getIrq(radio) ? OUTPUT_HIGH : OUTPUT_LOW;
+    }
+    std::lock_guard<std::mutex> lock(gpio_mutex);
+    std::map<rf24_gpio_pin_t, int>::iterator cached = gpio_values.find(port);
+    return cached == gpio_values.end() ? OUTPUT_LOW : cached->second;
+}
+
+void GPIO::write(rf24_gpio_pin_t port, int value)
+{
+    bool isCe;
+    int radio = VirtualAir::bindPin(port, true, &isCe);
+    if (radio >= 0 && isCe) {
+        VirtualAir::setCe(radio, value != OUTPUT_LOW);
+    }
+    std::lock_guard<std::mutex> lock(gpio_mutex);
+    gpio_values[port] = value;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file gpio.h
+ * Class declaration for the GPIO pins of the emulated radios
+ */
+#ifndef RF24_UTILITY_VIRTUAL_GPIO_H_
+#define RF24_UTILITY_VIRTUAL_GPIO_H_
+
+#include <stdexcept>
+#include <cstdint>
+
+typedef uint16_t rf24_gpio_pin_t;
+#define RF24_PIN_INVALID 0xFFFF
+
+/** Specific exception for GPIO errors */
+class GPIOException : public std::runtime_error
+{
+public:
+    explicit GPIOException(const std::string& msg)
+        : std::runtime_error(msg)
+    {
+    }
+};
+
+/**
+ * The pins of the emulated radios.
+ *
+ * Pins that are not bound to an emulated radio (see VirtualAir::bindPin()) simply
+ * remember the last value written to them.
+ */
+class GPIO
+{
+
+public:
+    static const int DIRECTION_OUT = 1;
+    static const int DIRECTION_IN = 0;
+
+    static const int OUTPUT_HIGH = 1;
+    static const int OUTPUT_LOW = 0;
+
+    GPIO();
+
+    static void open(rf24_gpio_pin_t port, int DDR);
+
+    static void close(rf24_gpio_pin_t port);
+
+    static int read(rf24_gpio_pin_t port);
+
+    static void write(rf24_gpio_pin_t port, int value);
+
+    virtual ~GPIO();
+};
+
+#endif // RF24_UTILITY_VIRTUAL_GPIO_H_
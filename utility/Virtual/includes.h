@@ -0,0 +1,9 @@
+#ifndef RF24_UTILITY_INCLUDES_H_
+#define RF24_UTILITY_INCLUDES_H_
+
+#define RF24_VIRTUAL
+
+#include <cstring> // memcpy() used in RF24.cpp
+#include "Virtual/RF24_arch_config.h"
+
+#endif // RF24_UTILITY_INCLUDES_H_
@@ -0,0 +1,192 @@
+/**
+ * Interrupt implementations
+ */
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <time.h> // clock_gettime()
+#include "air.h"
+#include "interrupt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Details related to a certain pin's ISR. */
+struct IrqPinCache
+{
+    /// The emulated radio the pin belongs to
+    int radio = -1;
+
+    /// The edge(s) that trigger the ISR
+    int mode = INT_EDGE_FALLING;
+
+    /// The pin's level when the ISR was attached
+    bool level = true;
+
+    /// The user-designated ISR function (used as a callback)
+    void (*function)(void) = nullptr;
+
+    /// The user-designated ISR function that takes a context pointer & the event details
+    void (*contextFunction)(void* context, const rf24_irq_event& event) = nullptr;
+
+    /// The context pointer passed to `contextFunction`
+    void* context = nullptr;
+
+    /// The pin's number (reported to `contextFunction`)
+    rf24_gpio_pin_t pin = 0;
+
+    /// Cleared to stop the thread
+    std::atomic<bool> running{true};
+
+    /// The thread that calls the ISR
+    std::thread thread;
+};
+
+static std::mutex irq_mutex;
+static std::map<rf24_gpio_pin_t, std::unique_ptr<IrqPinCache>> irqCache;
+
+// wait for each change of the pin's level and call the ISR on the requested edges
+static void watch_irq(IrqPinCache* pinCache)
+{
+    bool level = pinCache->level;
+    unsigned int seqno = 0;
+    while (pinCache->running) {
+        if (!VirtualAir::waitIrq(pinCache->radio, !level, 50)) {
+            continue;
+        }
+        level = !level;
+        int edge = level ? INT_EDGE_RISING : INT_EDGE_FALLING;
+        if (!(pinCache->mode & edge)) {
+            continue;
+        }
+        if (pinCache->contextFunction) {
+            rf24_irq_event event;
+            event.pin = pinCache->pin;
+            event.edge = edge;
+            event.seqno = ++seqno;
+            event.pending = 0; // each edge is detected on its own
+            if (level) {
+                timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                event.timestamp = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+            }
+            else {
+                event.timestamp = VirtualAir::getIrqTime(pinCache->radio);
+            }
+            pinCache->contextFunction(pinCache->context, event);
+        }
+        else {
+            pinCache->function();
+        }
+    }
+}
+
+// start a thread that calls the handler in `pinCache`
+static int attachHandler(rf24_gpio_pin_t pin, int mode, std::unique_ptr<IrqPinCache> pinCache)
+{
+    // ensure pin is not already being used in a separate thread
+    detachInterrupt(pin);
+
+    if (mode < INT_EDGE_FALLING || mode > INT_EDGE_BOTH) {
+        return 0; // bad user input!
+    }
+    bool isCe;
+    int radio = VirtualAir::bindPin(pin, false, &isCe);
+    if (radio < 0 || isCe) {
+        throw IRQException("[attachInterrupt] The pin is not the IRQ pin of a virtual radio");
+    }
+
+    pinCache->radio = radio;
+    pinCache->mode = mode;
+    pinCache->pin = pin;
+    pinCache->level = VirtualAir::getIrq(radio); // don't miss an edge while the thread starts
+    pinCache->thread = std::thread(watch_irq, pinCache.get());
+
+    std::lock_guard<std::mutex> lock(irq_mutex);
+    irqCache[pin] = std::move(pinCache);
+    return 1;
+}
+
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void))
+{
+    std::unique_ptr<IrqPinCache> pinCache(new IrqPinCache);
+    pinCache->function = function;
+    return attachHandler(pin, mode, std::move(pinCache));
+}
+
+int detachInterrupt(rf24_gpio_pin_t pin)
+{
+    std::unique_ptr<IrqPinCache> pinCache;
+    {
+        std::lock_guard<std::mutex> lock(irq_mutex);
+        std::map<rf24_gpio_pin_t, std::unique_ptr<IrqPinCache>>::iterator cachedPin = irqCache.find(pin);
+        if (cachedPin == irqCache.end()) {
+            return 0; // pin not in cache; just exit
+        }
+        pinCache = std::move(cachedPin->second);
+        irqCache.erase(cachedPin);
+    }
+    pinCache->running = false;
+    if (pinCache->thread.get_id() == std::this_thread::get_id()) {
+        pinCache->thread.detach(); // called from the ISR itself
+        pinCache.release();        // the thread still uses it (leaked once)
+    }
+    else {
+        pinCache->thread.join();
+    }
+    return 1;
+}
+
+int waitForInterrupt(rf24_gpio_pin_t pin, uint32_t timeout)
+{
+    bool isCe;
+    int radio = VirtualAir::bindPin(pin, false, &isCe);
+    if (radio < 0 || isCe) {
+        throw IRQException("[waitForInterrupt] The pin is not the IRQ pin of a virtual radio");
+    }
+    return VirtualAir::waitIrq(radio, false, timeout);
+}
+
+uint64_t getInterruptTime(rf24_gpio_pin_t pin)
+{
+    bool isCe;
+    int radio = VirtualAir::bindPin(pin, false, &isCe);
+    if (radio < 0 || isCe) {
+        throw IRQException("[getInterruptTime] The pin is not the IRQ pin of a virtual radio");
+    }
+    return VirtualAir::getIrqTime(radio);
+}
+
+// A simple struct instantiated privately to properly clean up open threads
+struct IrqCacheDestructor
+{
+    ~IrqCacheDestructor()
+    {
+        while (!irqCache.empty()) {
+            detachInterrupt(irqCache.begin()->first);
+        }
+    }
+} irqCacheMgr;
+
+void rfNoInterrupts()
+{
+}
+
+void rfInterrupts()
+{
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void* context, const rf24_irq_event& event), void* context)
+{
+    std::unique_ptr<IrqPinCache> pinCache(new IrqPinCache);
+    pinCache->contextFunction = function;
+    pinCache->context = context;
+    return attachHandler(pin, mode, std::move(pinCache));
+}
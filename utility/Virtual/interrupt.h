@@ -0,0 +1,102 @@
+/**
+ * @file interrupt.h
+ * Interrupt handlers for the IRQ pins of the emulated radios
+ */
+#ifndef RF24_UTILITY_VIRTUAL_INTERRUPT_H_
+#define RF24_UTILITY_VIRTUAL_INTERRUPT_H_
+
+#include <stdexcept>
+#include "gpio.h" // rf24_gpio_pin_t
+
+#define INT_EDGE_FALLING 1
+#define INT_EDGE_RISING  2
+#define INT_EDGE_BOTH    3
+
+// waitForInterrupt() is available
+#define IRQ_HAS_WAIT
+
+// getInterruptTime() is available
+#define IRQ_HAS_TIMESTAMP
+
+// attachInterrupt() accepts a handler with a context pointer & event details
+#define IRQ_HAS_CONTEXT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Specific exception for IRQ errors */
+class IRQException : public std::runtime_error
+{
+public:
+    explicit IRQException(const std::string& msg)
+        : std::runtime_error(msg)
+    {
+    }
+};
+
+/** Details of an edge detected on a pin (passed to a handler attached with a context pointer). */
+struct rf24_irq_event
+{
+    /// The pin that changed
+    rf24_gpio_pin_t pin;
+
+    /// The detected edge (`INT_EDGE_FALLING` or `INT_EDGE_RISING`)
+    int edge;
+
+    /// The sequence number of the event on this pin
+    unsigned int seqno;
+
+    /// The number of this pin's events that were detected with this one and are dispatched after it (always 0)
+    unsigned int pending;
+
+    /// When the edge occurred (in nanoseconds of `CLOCK_MONOTONIC`)
+    uint64_t timestamp;
+};
+
+/**
+ * Take the details and create an interrupt handler that will
+ * callback to the user-supplied function.
+ */
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void));
+
+/**
+ * Will cancel the interrupt thread.
+ */
+int detachInterrupt(rf24_gpio_pin_t pin);
+
+/**
+ * Block until the pin is driven LOW or the timeout expires.
+ *
+ * @param pin The pin to wait on.
+ * @param timeout The maximum time to wait (in milliseconds).
+ * @returns 1 if the pin is LOW, 0 if the timeout expired.
+ */
+int waitForInterrupt(rf24_gpio_pin_t pin, uint32_t timeout);
+
+/**
+ * Get the time of the latest falling edge on a pin.
+ *
+ * @param pin The pin to check.
+ * @returns The time of the latest falling edge (in nanoseconds of `CLOCK_MONOTONIC`),
+ * or 0 if no edge occurred yet.
+ */
+uint64_t getInterruptTime(rf24_gpio_pin_t pin);
+
+/** Deprecated, no longer functional */
+void rfNoInterrupts();
+
+/** Deprecated, no longer functional */
+void rfInterrupts();
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * Take the details and create an interrupt handler that will callback to the
+ * user-supplied function with the given context pointer and the details of each event.
+ */
+int attachInterrupt(rf24_gpio_pin_t pin, int mode, void (*function)(void* context, const rf24_irq_event& event), void* context);
+
+#endif // RF24_UTILITY_VIRTUAL_INTERRUPT_H_
@@ -0,0 +1,52 @@
+/**
+ * @file spi.cpp
+ * SPI bus of the emulated radios
+ */
+#include <string.h> // memcpy()
+#include "air.h"
+#include "spi.h"
+
+SPI::SPI()
+    : radio(-1)
+{
+}
+
+void SPI::begin(int busNo, uint32_t spi_speed)
+{
+    if (radio >= 0) {
+        return;
+    }
+    radio = VirtualAir::attach(static_cast<uint8_t>(busNo));
+    (void)spi_speed;
+}
+
+uint8_t SPI::transfer(uint8_t tx)
+{
+    VirtualAir::transfer(radio, &tx, 1);
+    return tx;
+}
+
+void SPI::transfernb(char* txBuf, char* rxBuf, uint32_t len)
+{
+    if (rxBuf != txBuf) {
+        memcpy(rxBuf, txBuf, len);
+    }
+    VirtualAir::transfer(radio, reinterpret_cast<uint8_t*>(rxBuf), len);
+}
+
+void SPI::transfern(char* buf, uint32_t len)
+{
+    VirtualAir::transfer(radio, reinterpret_cast<uint8_t*>(buf), len);
+}
+
+void SPI::transferBatch(char* buf, const uint8_t* lengths, uint8_t count)
+{
+    VirtualAir::transferBatch(radio, reinterpret_cast<uint8_t*>(buf), lengths, count);
+}
+
+SPI::~SPI()
+{
+    if (radio >= 0) {
+        VirtualAir::detach(radio);
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file spi.h
+ * Class declaration for the SPI bus of the emulated radios
+ */
+#ifndef RF24_UTILITY_VIRTUAL_SPI_H_
+#define RF24_UTILITY_VIRTUAL_SPI_H_
+
+#include <stdint.h>
+#include <stdexcept>
+
+#ifndef RF24_SPI_SPEED
+    #define RF24_SPI_SPEED 10000000
+#endif
+
+// this SPI class can submit several CSN-delimited frames at once
+#define SPI_HAS_BATCH
+
+/** The maximum number of frames that SPI::transferBatch() can submit at once */
+#define SPI_BATCH_MAX_FRAMES 32
+
+/** Specific exception for SPI errors */
+class SPIException : public std::runtime_error
+{
+public:
+    explicit SPIException(const std::string& msg)
+        : std::runtime_error(msg)
+    {
+    }
+};
+
+class SPI
+{
+
+public:
+    SPI();
+
+    /**
+     * Claim an emulated radio.
+     * @param busNo Only used to describe the radio. Any number of radios can use the same bus number.
+     * @param spi_speed Unused.
+     */
+    void begin(int busNo, uint32_t spi_speed = RF24_SPI_SPEED);
+
+    uint8_t transfer(uint8_t tx);
+
+    void transfernb(char* txBuf, char* rxBuf, uint32_t len);
+
+    void transfern(char* buf, uint32_t len);
+
+    /**
+     * Transfer several frames at once. The CSN line is released between each frame.
+     *
+     * @param buf The frames' data stored back to back. Each frame is transferred
+     * in place, so the received bytes overwrite the transmitted bytes.
+     * @param lengths The length of each frame.
+     * @param count The number of frames in @p buf (at most @ref SPI_BATCH_MAX_FRAMES).
+     */
+    void transferBatch(char* buf, const uint8_t* lengths, uint8_t count);
+
+    ~SPI();
+
+private:
+    int radio; /* the index of the emulated radio (-1 until begin() is called) */
+};
+
+#endif // RF24_UTILITY_VIRTUAL_SPI_H_
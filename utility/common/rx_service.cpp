@@ -0,0 +1,147 @@
+/**
+ * Background receive service implementation
+ */
+#include <string.h> // memcpy()
+#include <chrono>
+#include "rx_service.h"
+
+static uint32_t ring_size(uint32_t depth)
+{
+    uint32_t size = 2;
+    while (size < depth && size < 0x80000000UL) {
+        size <<= 1;
+    }
+    return size;
+}
+
+RF24RxService::RF24RxService(RF24& _radio, uint32_t depth, rf24_gpio_pin_t _irqPin)
+    : radio(_radio), irqPin(_irqPin), ring(ring_size(depth)), mask(ring_size(depth) - 1),
+      tail(0), cachedHead(0), lost(0), head(0), cachedTail(0), sleeping(false), running(false)
+{
+}
+
+RF24RxService::~RF24RxService()
+{
+    end();
+}
+
+void RF24RxService::begin()
+{
+    if (worker.joinable()) {
+        return; // already running
+    }
+    if (irqPin != RF24_PIN_INVALID) {
+        radio.setStatusFlags(RF24_RX_DR);
+#if defined(RF24_IRQ_WAIT)
+        radio.setIrqPin(irqPin); // timestamp the payloads with the IRQ pin's edges
+#endif
+    }
+    radio.startListening();
+    running = true;
+    worker = std::thread(&RF24RxService::run, this);
+}
+
+void RF24RxService::end()
+{
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool RF24RxService::available()
+{
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h == cachedTail) {
+        cachedTail = tail.load(std::memory_order_acquire);
+    }
+    return h != cachedTail;
+}
+
+bool RF24RxService::read(rf24_rx_packet_t& packet)
+{
+    if (!available()) {
+        return false;
+    }
+    uint32_t h = head.load(std::memory_order_relaxed);
+    packet = ring[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+bool RF24RxService::wait(rf24_rx_packet_t& packet, uint32_t timeout)
+{
+    if (read(packet)) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    sleeping.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the fence in publish()
+    arrived.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return available(); });
+    sleeping.store(false);
+    return read(packet);
+}
+
+uint32_t RF24RxService::dropped()
+{
+    return lost.load(std::memory_order_relaxed);
+}
+
+void RF24RxService::publish(uint8_t (*buffers)[32], rf24_rx_meta_t* meta, uint8_t count)
+{
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    for (uint8_t i = 0; i < count; ++i) {
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) {
+                lost.fetch_add(1, std::memory_order_relaxed); // the consumer is too slow
+                continue;
+            }
+        }
+        rf24_rx_packet_t& packet = ring[t & mask];
+        packet.timestamp = meta[i].timestamp;
+        packet.pipe = meta[i].pipe;
+        packet.length = meta[i].length;
+        memcpy(packet.data, buffers[i], meta[i].length);
+        tail.store(++t, std::memory_order_release);
+    }
+
+    // only take the mutex if the consumer might be sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrived.notify_one();
+    }
+}
+
+void RF24RxService::run()
+{
+    uint8_t buffers[3][32];
+    rf24_rx_meta_t meta[3];
+    while (running.load(std::memory_order_relaxed)) {
+        uint8_t count = radio.readAll(buffers, 3, meta);
+        if (count) {
+            publish(buffers, meta, count);
+        }
+        else {
+            waitForPayloads();
+        }
+    }
+}
+
+void RF24RxService::waitForPayloads()
+{
+#if defined(RF24_IRQ_WAIT)
+    if (irqPin != RF24_PIN_INVALID) {
+        if (radio.getStatusFlags() & RF24_RX_DR) {
+            // a stale flag (with an empty RX FIFO) would keep the IRQ pin asserted;
+            // check the RX FIFO again in case a payload arrived before the flag was cleared
+            radio.clearStatusFlags(RF24_RX_DR);
+            return;
+        }
+        waitForInterrupt(irqPin, 10);
+        return;
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::microseconds(RF24_RX_SERVICE_POLL_INTERVAL));
+}
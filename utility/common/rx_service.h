@@ -0,0 +1,149 @@
+/**
+ * @file rx_service.h
+ * A background receive service that keeps the radio's 3 level RX FIFO drained.
+ *
+ * A worker thread owns the radio (and the SPI bus) while the service is running. It empties
+ * the RX FIFO whenever payloads arrive and publishes them into a lock-free single-producer
+ * single-consumer ring. One consumer thread polls (or waits on) the ring without ever
+ * touching the radio, so a briefly slow consumer only fills the ring instead of the RX FIFO.
+ */
+#ifndef RF24_UTILITY_COMMON_RX_SERVICE_H_
+#define RF24_UTILITY_COMMON_RX_SERVICE_H_
+
+#include <stdint.h> // for uintXX_t types
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../RF24.h"
+
+#ifndef RF24_CACHE_LINE_SIZE
+    /** The alignment (in bytes) used to keep the producer's and consumer's data apart. */
+    #define RF24_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef RF24_RX_SERVICE_POLL_INTERVAL
+    /**
+     * The time (in microseconds) the worker waits between checks of the radio's RX FIFO
+     * when it is not sleeping on the radio's IRQ pin.
+     */
+    #define RF24_RX_SERVICE_POLL_INTERVAL 100
+#endif
+
+/**
+ * @brief A payload published by RF24RxService
+ *
+ * Each packet occupies its own cache line(s) in the ring.
+ */
+struct alignas(RF24_CACHE_LINE_SIZE) rf24_rx_packet_t
+{
+    /// When the payload was received (see rf24_rx_meta_t::timestamp).
+    uint64_t timestamp;
+    /// The pipe number that received the payload.
+    uint8_t pipe;
+    /// The length of the payload (in bytes).
+    uint8_t length;
+    /// The payload.
+    uint8_t data[32];
+};
+
+/**
+ * A receive service for an RF24 object.
+ *
+ * @code
+ * RF24RxService rx(radio, 256, IRQ_PIN);
+ * rx.begin(); // starts listening
+ * rf24_rx_packet_t packet;
+ * while (rx.wait(packet, 1000)) {
+ *   handle(packet.pipe, packet.data, packet.length);
+ * }
+ * rx.end();
+ * @endcode
+ *
+ * When the ring is full, newly received payloads are dropped (and counted by dropped()),
+ * while the packets already in the ring are kept for the consumer. So the consumer always
+ * gets the oldest packets in order, with a gap where the ring overflowed.
+ *
+ * @warning While the service is running (between begin() and end()), the worker thread
+ * is the only one allowed to communicate with the radio. Only one thread may consume
+ * packets with read() or wait().
+ */
+class RF24RxService
+{
+public:
+    /**
+     * @param radio The radio to receive with. Its RX addresses and payload settings
+     * should be configured before calling begin().
+     * @param depth The minimum number of packets the ring can hold (rounded up to a
+     * power of 2).
+     * @param irqPin The GPIO pin connected to the radio's IRQ pin. If given (and the
+     * driver can wait on pins), then the worker sleeps on the pin instead of polling
+     * the radio.
+     */
+    RF24RxService(RF24& radio, uint32_t depth, rf24_gpio_pin_t irqPin = RF24_PIN_INVALID);
+
+    /** Stops the worker thread. */
+    ~RF24RxService();
+
+    /**
+     * Put the radio in RX mode and start the worker thread.
+     *
+     * If an IRQ pin was given, then the radio's IRQ pin is configured to reflect only
+     * the `RF24_RX_DR` event.
+     */
+    void begin();
+
+    /** Stop the worker thread. The radio is left in RX mode. */
+    void end();
+
+    /** @returns `true` if a packet is waiting in the ring. */
+    bool available();
+
+    /**
+     * Take the oldest packet from the ring without blocking.
+     *
+     * @param[out] packet The packet taken from the ring.
+     * @returns `false` if the ring was empty.
+     */
+    bool read(rf24_rx_packet_t& packet);
+
+    /**
+     * Take the oldest packet from the ring, sleeping until one arrives.
+     *
+     * @param[out] packet The packet taken from the ring.
+     * @param timeout The maximum time to wait (in milliseconds).
+     * @returns `false` if no packet arrived within the timeout.
+     */
+    bool wait(rf24_rx_packet_t& packet, uint32_t timeout);
+
+    /** @returns The number of newly received payloads discarded because the ring was full. */
+    uint32_t dropped();
+
+private:
+    RF24& radio;
+    rf24_gpio_pin_t irqPin;
+    std::vector<rf24_rx_packet_t> ring;
+    uint32_t mask; /* ring.size() - 1 */
+
+    // written by the worker thread (the producer)
+    alignas(RF24_CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+    uint32_t cachedHead; /* the last value of head seen by the producer */
+    std::atomic<uint32_t> lost;
+
+    // written by the consumer
+    alignas(RF24_CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+    uint32_t cachedTail; /* the last value of tail seen by the consumer */
+    std::atomic<bool> sleeping;
+
+    alignas(RF24_CACHE_LINE_SIZE) std::atomic<bool> running;
+    std::mutex mutex;
+    std::condition_variable arrived; /* signals a sleeping consumer about new packets */
+    std::thread worker;
+
+    void run();
+    void publish(uint8_t (*buffers)[32], rf24_rx_meta_t* meta, uint8_t count);
+    void waitForPayloads();
+};
+
+#endif // RF24_UTILITY_COMMON_RX_SERVICE_H_
@@ -0,0 +1,89 @@
+/**
+ * High resolution delays and timestamps shared by the Linux drivers.
+ */
+#include <time.h>   // clock_gettime(), clock_nanosleep()
+#include <errno.h>  // EINTR
+#include <atomic>   // std::atomic
+#include "timing.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static uint64_t monotonic_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static const uint64_t start = monotonic_ns();
+
+// the wake-up latency of clock_nanosleep() compensated by spinning (shared by all threads)
+static std::atomic<uint32_t> slack(RF24_TIMING_INITIAL_SLACK);
+
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+void rf24_delay_ns(uint64_t nanoseconds)
+{
+    uint64_t deadline = monotonic_ns() + nanoseconds;
+    uint32_t reserve = slack.load(std::memory_order_relaxed);
+
+    if (nanoseconds > reserve + RF24_TIMING_MIN_SLEEP) {
+        uint64_t wake = deadline - reserve;
+        timespec req;
+        req.tv_sec = static_cast<time_t>(wake / 1000000000ULL);
+        req.tv_nsec = static_cast<long>(wake % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL) == EINTR) {
+        }
+
+        // adapt the slack to 1.5x the average wake-up latency
+        uint64_t latency = monotonic_ns() - wake;
+        if (latency > 2000000ULL) {
+            latency = 2000000ULL; // ignore outliers from preemption
+        }
+        int64_t target = static_cast<int64_t>(latency + latency / 2);
+        int64_t adjusted = reserve + (target - static_cast<int64_t>(reserve)) / 8;
+        slack.store(static_cast<uint32_t>(adjusted < 1000 ? 1000 : adjusted), std::memory_order_relaxed);
+    }
+
+    while (monotonic_ns() < deadline) {
+        cpu_relax();
+    }
+}
+
+void rf24_delay_us(uint32_t microseconds)
+{
+    rf24_delay_ns(microseconds * 1000ULL);
+}
+
+void rf24_delay_ms(uint32_t milliseconds)
+{
+    rf24_delay_ns(milliseconds * 1000000ULL);
+}
+
+uint32_t rf24_millis(void)
+{
+    return static_cast<uint32_t>((monotonic_ns() - start) / 1000000ULL);
+}
+
+uint32_t rf24_micros(void)
+{
+    return static_cast<uint32_t>((monotonic_ns() - start) / 1000ULL);
+}
+
+uint32_t rf24_delay_slack(void)
+{
+    return slack.load(std::memory_order_relaxed);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file timing.h
+ * High resolution delays and timestamps shared by the Linux drivers.
+ *
+ * Long delays sleep on `CLOCK_MONOTONIC` until shortly before the deadline and then
+ * spin for the remainder. The time reserved for spinning (the "slack") adapts to the
+ * wake-up latency observed after each sleep. Delays shorter than the slack are spun
+ * outright.
+ */
+#ifndef RF24_UTILITY_COMMON_TIMING_H_
+#define RF24_UTILITY_COMMON_TIMING_H_
+
+#include <stdint.h> // for uintXX_t types
+
+#ifndef RF24_TIMING_INITIAL_SLACK
+    /** The time (in nanoseconds) spun at the end of a delay before any sleep was measured. */
+    #define RF24_TIMING_INITIAL_SLACK 100000
+#endif
+
+#ifndef RF24_TIMING_MIN_SLEEP
+    /** Delays (in nanoseconds) that would leave less than this to sleep are spun outright. */
+    #define RF24_TIMING_MIN_SLEEP 20000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Wait for the specified number of nanoseconds. */
+void rf24_delay_ns(uint64_t nanoseconds);
+
+/** Wait for the specified number of microseconds. */
+void rf24_delay_us(uint32_t microseconds);
+
+/** Wait for the specified number of milliseconds. */
+void rf24_delay_ms(uint32_t milliseconds);
+
+/** The number of milliseconds since the program started (wraps after ~49 days). */
+uint32_t rf24_millis(void);
+
+/** The number of microseconds since the program started (wraps after ~71 minutes). */
+uint32_t rf24_micros(void);
+
+/** The time (in nanoseconds) currently reserved for spinning at the end of a delay. */
+uint32_t rf24_delay_slack(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RF24_UTILITY_COMMON_TIMING_H_
@@ -0,0 +1,236 @@
+/**
+ * Software TX queue implementation
+ */
+#include <string.h> // memcpy()
+#include <chrono>
+#include <memory>
+#include "tx_queue.h"
+
+RF24TxQueue::RF24TxQueue(RF24& _radio, uint16_t depth, rf24_gpio_pin_t _irqPin)
+    : radio(_radio), irqPin(_irqPin), ring(depth ? depth : 1), head(0), count(0), inFlight(0), resendLimit(0), running(false)
+{
+}
+
+RF24TxQueue::~RF24TxQueue()
+{
+    end(0);
+}
+
+void RF24TxQueue::begin()
+{
+    if (worker.joinable()) {
+        return; // already running
+    }
+    if (irqPin != RF24_PIN_INVALID) {
+        radio.setStatusFlags(RF24_TX_DS | RF24_TX_DF);
+    }
+    radio.clearStatusFlags();
+    running = true;
+    worker = std::thread(&RF24TxQueue::run, this);
+}
+
+bool RF24TxQueue::end(uint32_t timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    bool done = !count && !inFlight;
+    if (worker.joinable()) {
+        done = idle.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return !count && !inFlight; });
+    }
+    running = false;
+    wake.notify_all();
+    lock.unlock();
+    if (worker.joinable()) {
+        worker.join();
+        radio.ce(LOW);
+    }
+
+    // the radio belongs to the caller again; give up on the payloads left over
+    if (!fifo.empty()) {
+        radio.flush_tx();
+        radio.clearStatusFlags(RF24_TX_DS | RF24_TX_DF);
+        while (!fifo.empty()) {
+            finish(fifo.front(), false);
+            fifo.pop_front();
+        }
+    }
+    Item item;
+    while (pop(item)) {
+        finish(item, false);
+    }
+    lock.lock();
+    inFlight = 0;
+    return done;
+}
+
+bool RF24TxQueue::enqueue(const void* buf, uint8_t len, rf24_tx_callback_t callback, bool multicast)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == ring.size()) {
+        return false;
+    }
+    Item& item = ring[(head + count) % ring.size()];
+    item.len = rf24_min(len, static_cast<uint8_t>(32));
+    memcpy(item.buf, buf, item.len);
+    item.multicast = multicast;
+    item.resends = 0;
+    item.callback = std::move(callback);
+    count++;
+    wake.notify_one();
+    return true;
+}
+
+std::future<bool> RF24TxQueue::enqueueFuture(const void* buf, uint8_t len, bool multicast)
+{
+    std::shared_ptr<std::promise<bool>> promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+    if (!enqueue(buf, len, [promise](bool success) { promise->set_value(success); }, multicast)) {
+        promise->set_value(false);
+    }
+    return result;
+}
+
+void RF24TxQueue::setResendLimit(uint8_t limit)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    resendLimit = limit;
+}
+
+uint32_t RF24TxQueue::pending()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return count + inFlight;
+}
+
+bool RF24TxQueue::pop(Item& item)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!count) {
+        return false;
+    }
+    item = std::move(ring[head]);
+    head = (head + 1) % ring.size();
+    count--;
+    return true;
+}
+
+void RF24TxQueue::finish(Item& item, bool success)
+{
+    if (item.callback) {
+        item.callback(success);
+        item.callback = nullptr;
+    }
+}
+
+void RF24TxQueue::run()
+{
+    bool active = false; // is CE already HIGH?
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return !running || count || inFlight; });
+        if (!running) {
+            break;
+        }
+        lock.unlock();
+
+        refill();
+        if (!active && !fifo.empty()) {
+            radio.ce(HIGH);
+            active = true;
+        }
+
+        // clear TX_DS before checking the FIFO, so any later transmission asserts the IRQ pin again
+        uint8_t flags = radio.clearStatusFlags(RF24_TX_DS);
+        rf24_fifo_state_e state = radio.isFifo(true);
+        if (flags & RF24_TX_DF) {
+            handleFailure(state);
+        }
+        else if (state == RF24_FIFO_EMPTY) {
+            complete(fifo.size());
+        }
+        else if (state != RF24_FIFO_FULL && fifo.size() > 2) {
+            // the FIFO holds 1 or 2 payloads; only count the completion that is certain
+            complete(fifo.size() - 2);
+        }
+
+        lock.lock();
+        inFlight = fifo.size();
+        if (!count && !inFlight) {
+            idle.notify_all();
+        }
+        else if (inFlight == 3) {
+            // nothing can be written until a transmission is done
+            lock.unlock();
+            waitForSpace();
+            lock.lock();
+        }
+        else if (!count) {
+            // keep checking on the payloads in the TX FIFO unless more payloads arrive
+            wake.wait_for(lock, std::chrono::microseconds(RF24_TX_QUEUE_POLL_INTERVAL), [this] { return !running || count; });
+        }
+    }
+}
+
+void RF24TxQueue::refill()
+{
+    Item item;
+    while (fifo.size() < 3 && pop(item)) {
+        radio.startFastWrite(item.buf, item.len, item.multicast, false);
+        fifo.push_back(std::move(item));
+    }
+}
+
+void RF24TxQueue::complete(size_t done)
+{
+    for (; done && !fifo.empty(); --done) {
+        finish(fifo.front(), true);
+        fifo.pop_front();
+    }
+}
+
+void RF24TxQueue::handleFailure(rf24_fifo_state_e state)
+{
+    // The radio halts with the failed payload at the top of its TX FIFO. Anything ahead of it
+    // in the queue was sent, but the FIFO_STATUS register can't tell 1 payload from 2.
+    size_t occupied = state == RF24_FIFO_FULL ? 3 : (state == RF24_FIFO_EMPTY ? 0 : 1);
+    if (state == RF24_FIFO_OCCUPIED && fifo.size() > 1) {
+        // nothing is transmitted while TX_DF is asserted, so probe the FIFO with a throw-away payload
+        radio.startFastWrite(fifo.back().buf, fifo.back().len, false, false);
+        occupied = radio.isFifo(true) == RF24_FIFO_FULL ? 2 : 1;
+    }
+    complete(fifo.size() > occupied ? fifo.size() - occupied : 0);
+
+    radio.flush_tx();
+    if (!fifo.empty()) {
+        uint8_t limit;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            limit = resendLimit;
+        }
+        if (fifo.front().resends < limit) {
+            fifo.front().resends++;
+        }
+        else {
+            finish(fifo.front(), false);
+            fifo.pop_front();
+        }
+        for (std::deque<Item>::iterator i = fifo.begin(); i != fifo.end(); ++i) {
+            radio.startFastWrite(i->buf, i->len, i->multicast, false);
+        }
+    }
+    radio.clearStatusFlags(RF24_TX_DF);
+
+    // restart the transmissions
+    radio.ce(LOW);
+    radio.ce(HIGH);
+}
+
+void RF24TxQueue::waitForSpace()
+{
+#if defined(RF24_IRQ_WAIT)
+    if (irqPin != RF24_PIN_INVALID) {
+        waitForInterrupt(irqPin, 1);
+        return;
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::microseconds(RF24_TX_QUEUE_POLL_INTERVAL));
+}
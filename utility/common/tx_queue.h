@@ -0,0 +1,162 @@
+/**
+ * @file tx_queue.h
+ * An asynchronous software TX queue that keeps the radio's 3 level TX FIFO fed.
+ *
+ * Producer threads only copy their payloads into a software ring. A worker thread owns
+ * the radio (and the SPI bus) while the queue is running: it refills the TX FIFO as soon
+ * as space becomes available and reports the outcome of each payload to its producer.
+ */
+#ifndef RF24_UTILITY_COMMON_TX_QUEUE_H_
+#define RF24_UTILITY_COMMON_TX_QUEUE_H_
+
+#include <stdint.h> // for uintXX_t types
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../RF24.h"
+
+#ifndef RF24_TX_QUEUE_POLL_INTERVAL
+    /**
+     * The time (in microseconds) the worker waits between checks of the radio's FIFO
+     * when it is not sleeping on the radio's IRQ pin.
+     */
+    #define RF24_TX_QUEUE_POLL_INTERVAL 100
+#endif
+
+/**
+ * A callback invoked once a queued payload is done. This is called from the worker thread
+ * (or from RF24TxQueue::end() for the payloads it gives up on).
+ * The argument is `true` if the payload was sent (and acknowledged if auto-ack is enabled)
+ * or `false` if it was dropped after exhausting the allowed retries.
+ */
+typedef std::function<void(bool)> rf24_tx_callback_t;
+
+/**
+ * A software TX queue for an RF24 object.
+ *
+ * @code
+ * RF24TxQueue queue(radio, 64, IRQ_PIN);
+ * radio.stopListening();
+ * queue.begin();
+ * queue.enqueue(&payload, sizeof(payload), [](bool ok) { sent += ok; });
+ * std::future<bool> last = queue.enqueueFuture(&payload, sizeof(payload));
+ * last.wait();
+ * queue.end();
+ * @endcode
+ *
+ * @warning While the queue is running (between begin() and end()), the worker thread is
+ * the only one allowed to communicate with the radio. Do not call any RF24 functions
+ * from other threads in that time.
+ */
+class RF24TxQueue
+{
+public:
+    /**
+     * @param radio The radio to transmit with. Its TX address and auto-ack settings
+     * should be configured before calling begin().
+     * @param depth The maximum number of payloads held by the software ring (not
+     * including the 3 payloads in the radio's TX FIFO).
+     * @param irqPin The GPIO pin connected to the radio's IRQ pin. If given (and the
+     * driver can wait on pins), then the worker sleeps on the pin instead of polling
+     * the radio while the TX FIFO is full.
+     */
+    RF24TxQueue(RF24& radio, uint16_t depth, rf24_gpio_pin_t irqPin = RF24_PIN_INVALID);
+
+    /** Stops the worker thread; payloads still queued are reported as failed. */
+    ~RF24TxQueue();
+
+    /**
+     * Start the worker thread.
+     *
+     * The radio is expected to be in TX mode (see RF24::stopListening()) with an empty
+     * TX FIFO. If an IRQ pin was given, then the radio's IRQ pin is configured to
+     * reflect only the `RF24_TX_DS` and `RF24_TX_DF` events.
+     */
+    void begin();
+
+    /**
+     * Stop the worker thread after it is done with all queued payloads.
+     *
+     * @param timeout The maximum time (in milliseconds) to wait for the queued
+     * payloads. Any payloads left afterward are flushed and reported as failed.
+     * If the worker is not running (begin() was not called), this doesn't wait.
+     * @returns `true` if all payloads were done within the timeout.
+     */
+    bool end(uint32_t timeout = 1000);
+
+    /**
+     * Queue a payload without blocking.
+     *
+     * @param buf The payload to copy into the queue.
+     * @param len The payload's length (truncated to 32 bytes).
+     * @param callback An optional callback to invoke (from the worker thread) with the
+     * payload's outcome.
+     * @param multicast Send the payload without requesting an acknowledgement.
+     * @returns `false` if the software ring is full (the payload was not queued).
+     */
+    bool enqueue(const void* buf, uint8_t len, rf24_tx_callback_t callback, bool multicast = false);
+
+    /**
+     * Queue a payload and get its outcome as a future.
+     *
+     * @returns A future that resolves to `true` if the payload was sent or `false` if
+     * it was dropped (or if the software ring was full).
+     */
+    std::future<bool> enqueueFuture(const void* buf, uint8_t len, bool multicast = false);
+
+    /**
+     * Set how often a failed payload is re-sent before it is dropped.
+     *
+     * A payload fails once the radio exhausts its auto-retries (see RF24::setRetries())
+     * without receiving an ACK. The payload is then flushed from the TX FIFO and either
+     * re-queued ahead of the other payloads or dropped and reported as failed.
+     *
+     * @param limit The number of times a failed payload is re-sent. `0` (the default)
+     * drops failed payloads right away.
+     *
+     * @note A re-sent payload is written to the TX FIFO again, so the receiver may get a
+     * duplicate if only the ACK was lost.
+     */
+    void setResendLimit(uint8_t limit);
+
+    /** @returns The number of payloads not done yet (including those in the radio's TX FIFO). */
+    uint32_t pending();
+
+private:
+    struct Item
+    {
+        uint8_t buf[32];
+        uint8_t len;
+        bool multicast;
+        uint8_t resends;
+        rf24_tx_callback_t callback;
+    };
+
+    RF24& radio;
+    rf24_gpio_pin_t irqPin;
+    std::vector<Item> ring;  /* the software ring of payloads not yet written to the radio */
+    uint16_t head;           /* the index of the oldest payload in the ring */
+    uint16_t count;          /* the number of payloads in the ring */
+    std::deque<Item> fifo;   /* the payloads in the radio's TX FIFO (in transmission order); only used by the worker */
+    uint32_t inFlight;       /* the size of fifo, as seen by other threads */
+    uint8_t resendLimit;
+    bool running;
+    std::mutex mutex;
+    std::condition_variable wake; /* signals the worker about new payloads or end() */
+    std::condition_variable idle; /* signals end() that the queue is empty */
+    std::thread worker;
+
+    void run();
+    bool pop(Item& item);
+    void refill();
+    void complete(size_t done);
+    void handleFailure(rf24_fifo_state_e state);
+    void waitForSpace();
+    void finish(Item& item, bool success);
+};
+
+#endif // RF24_UTILITY_COMMON_TX_QUEUE_H_
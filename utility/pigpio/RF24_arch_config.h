@@ -67,5 +67,6 @@ typedef uint8_t rf24_gpio_pin_t;
 #define delay(millisec)          __msleep(millisec)
 #define delayMicroseconds(usec)  __usleep(usec)
 #define millis()                 __millis()
+#define micros()                 __micros()
 
 #endif // RF24_UTILITY_PIGPIO_RF24_ARCH_CONFIG_H_
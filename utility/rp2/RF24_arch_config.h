@@ -58,5 +58,6 @@ typedef uint8_t rf24_gpio_pin_t;
 #define delay(millisec)          sleep_ms(millisec)
 #define delayMicroseconds(usec)  sleep_us(usec)
 #define millis()                 to_ms_since_boot(get_absolute_time())
+#define micros()                 to_us_since_boot(get_absolute_time())
 
 #endif // RF24_UTILITY_RP2_RF24_ARCH_CONFIG_H_
@@ -1,5 +1,8 @@
 #include "spi.h"
 
+// the speed each hardware SPI bus was configured with (0 means unconfigured)
+static uint32_t busSpeed[NUM_SPIS] = {0};
+
 SPI::SPI()
 {
 }
@@ -36,13 +39,22 @@ void SPI::transfern(const uint8_t* buf, uint32_t len)
 
 void SPI::beginTransaction(uint32_t _spi_speed)
 {
-    spi_init(_hw_id, _spi_speed);
-    spi_set_format(_hw_id, RF24_SPI_BYTE_SIZE, RF24_SPI_CPOL, RF24_SPI_CPHA, RF24_SPI_ENDIAN);
+    uint32_t& configured = busSpeed[spi_get_index(_hw_id)];
+    if (configured != _spi_speed) {
+        spi_init(_hw_id, _spi_speed);
+        spi_set_format(_hw_id, RF24_SPI_BYTE_SIZE, RF24_SPI_CPOL, RF24_SPI_CPHA, RF24_SPI_ENDIAN);
+        configured = _spi_speed;
+    }
 }
 
 void SPI::endTransaction()
+{
+}
+
+void SPI::end()
 {
     spi_deinit(_hw_id);
+    busSpeed[spi_get_index(_hw_id)] = 0;
 }
 
 SPI::~SPI()
@@ -14,8 +14,7 @@
 #define RF24_SPI_CPHA      SPI_CPHA_0
 #define RF24_SPI_CPOL      SPI_CPOL_0
 
-// this SPI class uses beginTransaction() & endTransaction() to
-// implement spi_init() & spi_deinit()
+// this SPI class uses beginTransaction() to (re)configure the bus with spi_init()
 #define SPI_HAS_TRANSACTION 1
 
 class SPI
@@ -55,11 +54,23 @@ public:
 
     void transfern(const uint8_t* buf, uint32_t len);
 
+    /**
+     * Configure the SPI bus (using hw_id passed to begin()) for a transaction.
+     *
+     * The bus stays configured between transactions. It is only reconfigured
+     * when a different speed was requested by the bus' last transaction.
+     *
+     * @note Other code that reconfigures the same hardware SPI bus should call end()
+     * to make the next transaction restore its settings.
+     */
     void beginTransaction(uint32_t _spi_speed);
 
-    /** deinit the SPI bus (using hw_id passed to begin()) */
+    /** Conclude a transaction. The bus keeps its configuration. */
     void endTransaction();
 
+    /** deinit the SPI bus (using hw_id passed to begin()) */
+    void end();
+
     virtual ~SPI();
 
 private: